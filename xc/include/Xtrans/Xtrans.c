@@ -0,0 +1 @@
+/root/repo/xc/lib/xtrans/Xtrans.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/xc/lib/xtrans/Xtrans.h
\ No newline at end of file
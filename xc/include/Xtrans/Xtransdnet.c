@@ -0,0 +1 @@
+/root/repo/xc/lib/xtrans/Xtransdnet.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/xc/lib/xtrans/Xtransint.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/xc/lib/xtrans/Xtranslcl.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/xc/lib/xtrans/Xtransshm.c
\ No newline at end of file
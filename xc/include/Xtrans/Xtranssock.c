@@ -0,0 +1 @@
+/root/repo/xc/lib/xtrans/Xtranssock.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/xc/lib/xtrans/Xtranstli.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/xc/lib/xtrans/Xtransutil.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/xc/lib/xtrans/transport.c
\ No newline at end of file
@@ -245,6 +245,7 @@ extern int	XkbKeyboardErrorCode;
 extern int	XkbDisableLockActions;
 extern char *	XkbBaseDirectory;
 extern char *	XkbInitialMap;
+extern int	XkbKeymapCache;
 extern int	_XkbClientMajor;
 extern int	_XkbClientMinor;
 extern unsigned	int XkbXIUnsupported;
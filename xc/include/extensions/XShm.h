@@ -158,6 +158,17 @@ XImage *XShmCreateImage(
 #endif
 );
 
+XImage *XShmCreateSharedImage(
+#if NeedFunctionPrototypes
+    Display*		/* dpy */,
+    Visual*		/* visual */,
+    unsigned int	/* depth */,
+    int			/* format */,
+    unsigned int	/* width */,
+    unsigned int	/* height */
+#endif
+);
+
 Pixmap XShmCreatePixmap(
 #if NeedFunctionPrototypes
     Display*		/* dpy */,
@@ -38,6 +38,7 @@
 #define X_FontCacheGetCacheSettings	1
 #define X_FontCacheChangeCacheSettings	2
 #define X_FontCacheGetCacheStatistics	3
+#define X_FontCacheGetNameCacheStatistics	4
 
 #define FontCacheNumberEvents		0
 
@@ -66,6 +67,14 @@ typedef struct {
     struct cacheinfo	v;
 } FontCacheStatistics, *FontCacheStatisticsPtr;
 
+typedef struct {
+    long	open_hits;
+    long	open_misses;
+    long	list_hits;
+    long	list_misses;
+    long	flushes;
+} FontCacheNameStatistics, *FontCacheNameStatisticsPtr;
+
 #ifndef _FONTCACHE_SERVER_
 
 #include <X11/Xlib.h>
@@ -109,6 +118,13 @@ Status FontCacheGetCacheStatistics(
 #endif
 );
 
+Status FontCacheGetNameCacheStatistics(
+#if NeedFunctionPrototypes
+    Display*			/* dpy */,
+    FontCacheNameStatistics*	/* name cache statistics info */
+#endif
+);
+
 _XFUNCPROTOEND
 
 #endif /* !_FONTCACHE_SERVER_ */
@@ -39,7 +39,7 @@
 #define FONTCACHENAME		"FontCache"
 
 #define FONTCACHE_MAJOR_VERSION	0	/* current version numbers */
-#define FONTCACHE_MINOR_VERSION	1
+#define FONTCACHE_MINOR_VERSION	2
 
 typedef struct _FontCacheQueryVersion {
     CARD8	reqType;		/* always FontCacheReqCode */
@@ -127,4 +127,25 @@ typedef struct {
 } xFontCacheGetCacheStatisticsReply;
 #define sz_xFontCacheGetCacheStatisticsReply	64
 
+typedef struct _FontCacheGetNameCacheStatistics {
+    CARD8	reqType;		/* always FontCacheReqCode */
+    CARD8	fontcacheReqType;	/* always X_FontCacheGetNameCacheStatistics */
+    CARD16	length B16;
+} xFontCacheGetNameCacheStatisticsReq;
+#define sz_xFontCacheGetNameCacheStatisticsReq	4
+
+typedef struct {
+    BYTE	type;			/* X_Reply */
+    BOOL	pad1;
+    CARD16	sequenceNumber B16;
+    CARD32	length B32;
+    CARD32	open_hits B32;
+    CARD32	open_misses B32;
+    CARD32	list_hits B32;
+    CARD32	list_misses B32;
+    CARD32	flushes B32;
+    CARD32	reserve0 B32;
+} xFontCacheGetNameCacheStatisticsReply;
+#define sz_xFontCacheGetNameCacheStatisticsReply	32
+
 #endif /* _FONTCACHESTR_H_ */
@@ -69,6 +69,7 @@ XCloseDisplay (dpy)
 	    if (dpy->request != dpy->last_request_read)
 		XSync(dpy, 1);
 	}
+	_XFreeReplyCookies(dpy);
 	_XDisconnectDisplay(dpy->trans_conn);
 	_XFreeDisplayStructure (dpy);
 	return 0;
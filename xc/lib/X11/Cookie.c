@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2003  XFree86 Inc
+ */
+/* $XFree86$ */
+
+/*
+ * Reply cookies let a client issue several reply-bearing requests and
+ * collect the replies afterwards, paying one round trip for the lot.
+ * Each cookie is an async handler keyed on the sequence number of its
+ * request; the handler stores the reply, or the error, which then does
+ * not reach the error handler.  Waiting on a cookie whose reply has
+ * not been read yet costs a GetInputFocus round trip, after which
+ * every earlier cookie is complete as well.
+ */
+
+#define NEED_REPLIES
+#include "Xlibint.h"
+
+static Bool
+_XReplyCookieHandler(dpy, rep, buf, len, data)
+    register Display *dpy;
+    register xReply *rep;
+    char *buf;
+    int len;
+    XPointer data;
+{
+    register XReplyCookie cookie = (XReplyCookie)data;
+    int size;
+
+    if (dpy->last_request_read != cookie->sequence)
+	return False;
+    DeqAsyncHandler(dpy, &cookie->async);
+    if (rep->generic.type == X_Error) {
+	if (cookie->state == ReplyCookieDiscarded) {
+	    _XFreeReplyCookie(cookie);
+	    return True;
+	}
+	cookie->error = rep->error;
+	cookie->state = ReplyCookieFailed;
+	return True;
+    }
+    size = SIZEOF(xReply) + (rep->generic.length << 2);
+    if (cookie->state == ReplyCookieDiscarded) {
+	_XGetAsyncData(dpy, (char *)NULL, buf, len, 0, size, 0);
+	_XFreeReplyCookie(cookie);
+	return True;
+    }
+    if (!(cookie->reply = Xmalloc(size))) {
+	_XGetAsyncData(dpy, (char *)NULL, buf, len, 0, size, 0);
+	cookie->error.type = X_Error;
+	cookie->error.errorCode = BadAlloc;
+	cookie->state = ReplyCookieFailed;
+	return True;
+    }
+    _XGetAsyncData(dpy, cookie->reply, buf, len, 0, size, 0);
+    cookie->state = ReplyCookieReplied;
+    return True;
+}
+
+/*
+ * The cookie must exist before its request is sent: a reply nobody
+ * claims would be taken by the next _XReply as its own.
+ */
+XReplyCookie
+_XAllocReplyCookie(closure)
+    XPointer closure;
+{
+    XReplyCookie cookie;
+
+    if (!(cookie = (XReplyCookie)Xcalloc(1, sizeof(struct _XReplyCookie))))
+	return NULL;
+    cookie->state = ReplyCookiePending;
+    cookie->closure = closure;
+    return cookie;
+}
+
+/* called with the display locked, right after the request is queued */
+void
+_XQueueReplyCookie(dpy, cookie)
+    register Display *dpy;
+    register XReplyCookie cookie;
+{
+    cookie->sequence = dpy->request;
+    cookie->async.next = dpy->async_handlers;
+    cookie->async.handler = _XReplyCookieHandler;
+    cookie->async.data = (XPointer)cookie;
+    dpy->async_handlers = &cookie->async;
+}
+
+/* returns the whole reply, or NULL if the request failed */
+char *
+_XWaitReplyCookie(dpy, cookie)
+    register Display *dpy;
+    register XReplyCookie cookie;
+{
+    xGetInputFocusReply rep;
+    register xReq *req;
+
+    if (cookie->state == ReplyCookiePending) {
+	GetEmptyReq(GetInputFocus, req);
+	(void) _XReply(dpy, (xReply *)&rep, 0, xTrue);
+	if (cookie->state == ReplyCookiePending) {
+	    /* the connection is gone */
+	    DeqAsyncHandler(dpy, &cookie->async);
+	    cookie->state = ReplyCookieFailed;
+	    cookie->error.type = X_Error;
+	    cookie->error.errorCode = BadImplementation;
+	}
+    }
+    return (cookie->state == ReplyCookieReplied) ? cookie->reply : NULL;
+}
+
+void
+_XFreeReplyCookie(cookie)
+    XReplyCookie cookie;
+{
+    if (cookie->reply)
+	Xfree(cookie->reply);
+    if (cookie->closure)
+	Xfree(cookie->closure);
+    Xfree((char *)cookie);
+}
+
+/*
+ * Called from XCloseDisplay: cookies still queued then can never be
+ * completed, and nobody may use them once the display is gone.
+ */
+void
+_XFreeReplyCookies(dpy)
+    register Display *dpy;
+{
+    register _XAsyncHandler **prev, *async;
+
+    for (prev = &dpy->async_handlers; (async = *prev); ) {
+	if (async->handler == _XReplyCookieHandler) {
+	    *prev = async->next;
+	    _XFreeReplyCookie((XReplyCookie)async->data);
+	} else
+	    prev = &async->next;
+    }
+}
+
+Bool
+XReplyCookieError(dpy, cookie, error)
+    register Display *dpy;
+    register XReplyCookie cookie;
+    XErrorEvent *error;
+{
+    Bool failed;
+
+    if (!cookie)
+	return False;
+    LockDisplay(dpy);
+    failed = !_XWaitReplyCookie(dpy, cookie);
+    if (failed && error) {
+	error->type = X_Error;
+	error->display = dpy;
+	error->resourceid = cookie->error.resourceID;
+	error->serial = cookie->sequence;
+	error->error_code = cookie->error.errorCode;
+	error->request_code = cookie->error.majorCode;
+	error->minor_code = cookie->error.minorCode;
+    }
+    UnlockDisplay(dpy);
+    return failed;
+}
+
+void
+XDiscardReplyCookie(dpy, cookie)
+    register Display *dpy;
+    register XReplyCookie cookie;
+{
+    if (!cookie)
+	return;
+    LockDisplay(dpy);
+    if (cookie->state == ReplyCookiePending)
+	cookie->state = ReplyCookieDiscarded;	/* the handler frees it */
+    else
+	_XFreeReplyCookie(cookie);
+    UnlockDisplay(dpy);
+}
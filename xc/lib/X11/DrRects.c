@@ -28,6 +28,11 @@ in this Software without prior written authorization from The Open Group.
 
 #include "Xlibint.h"
 
+/* precompute the maximum size of batching request allowed */
+
+#define wsize (SIZEOF(xPolyRectangleReq) + WRCTSPERBATCH * SIZEOF(xRectangle))
+#define zsize (SIZEOF(xPolyRectangleReq) + ZRCTSPERBATCH * SIZEOF(xRectangle))
+
 int
 XDrawRectangles(dpy, d, gc, rects, n_rects)
 register Display *dpy;
@@ -42,6 +47,14 @@ int n_rects;
 
     LockDisplay(dpy);
     FlushGC(dpy, gc);
+    len = ((long)n_rects) * SIZEOF(xRectangle);
+    /* if same as previous request, with same drawable, batch requests */
+    if (n_rects &&
+	_XExtendPolyRequest(dpy, X_PolyRectangle, d, gc, len,
+			    (gc->values.line_width ? wsize : zsize))) {
+	Data16 (dpy, (short *) rects, len);
+	n_rects = 0;
+    }
     while (n_rects) {
 	GetReq(PolyRectangle, req);
 	req->drawable = d;
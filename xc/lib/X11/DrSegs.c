@@ -28,6 +28,11 @@ in this Software without prior written authorization from The Open Group.
 
 #include "Xlibint.h"
 
+/* precompute the maximum size of batching request allowed */
+
+#define wsize (SIZEOF(xPolySegmentReq) + WLNSPERBATCH * SIZEOF(xSegment))
+#define zsize (SIZEOF(xPolySegmentReq) + ZLNSPERBATCH * SIZEOF(xSegment))
+
 int
 XDrawSegments (dpy, d, gc, segments, nsegments)
     register Display *dpy;
@@ -42,6 +47,14 @@ XDrawSegments (dpy, d, gc, segments, nsegments)
 
     LockDisplay(dpy);
     FlushGC(dpy, gc);
+    len = ((long)nsegments) * SIZEOF(xSegment);
+    /* if same as previous request, with same drawable, batch requests */
+    if (nsegments &&
+	_XExtendPolyRequest(dpy, X_PolySegment, d, gc, len,
+			    (gc->values.line_width ? wsize : zsize))) {
+	Data16 (dpy, (short *) segments, len);
+	nsegments = 0;
+    }
     while (nsegments) {
 	GetReq (PolySegment, req);
 	req->drawable = d;
@@ -0,0 +1,25 @@
+/*
+ * Copyright (c) 2003  XFree86 Inc
+ */
+/* $XFree86$ */
+
+#include "Xlibint.h"
+
+/*
+ * Select the event kinds _XEnq may merge as they are queued:
+ * PointerMotionMask for MotionNotify, ExposureMask for Expose.
+ * Returns the previous mask.
+ */
+long
+XSetEventCompression(dpy, event_mask)
+    register Display *dpy;
+    long event_mask;
+{
+    long old;
+
+    LockDisplay(dpy);
+    old = dpy->compress_mask;
+    dpy->compress_mask = event_mask & (PointerMotionMask|ExposureMask);
+    UnlockDisplay(dpy);
+    return old;
+}
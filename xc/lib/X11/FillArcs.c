@@ -28,6 +28,10 @@ in this Software without prior written authorization from The Open Group.
 
 #include "Xlibint.h"
 
+/* precompute the maximum size of batching request allowed */
+
+#define size (SIZEOF(xPolyFillArcReq) + FARCSPERBATCH * SIZEOF(xArc))
+
 #define arc_scale (SIZEOF(xArc) / 4)
 
 int
@@ -44,6 +48,14 @@ int n_arcs;
 
     LockDisplay(dpy);
     FlushGC(dpy, gc);
+    len = ((long)n_arcs) * SIZEOF(xArc);
+    /* if same as previous request, with same drawable, batch requests */
+    if (n_arcs &&
+	_XExtendPolyRequest(dpy, X_PolyFillArc, d, gc, len,
+			    size)) {
+	Data16 (dpy, (short *) arcs, len);
+	n_arcs = 0;
+    }
     while (n_arcs) {
 	GetReq(PolyFillArc, req);
 	req->drawable = d;
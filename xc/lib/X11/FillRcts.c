@@ -28,6 +28,10 @@ in this Software without prior written authorization from The Open Group.
 
 #include "Xlibint.h"
 
+/* precompute the maximum size of batching request allowed */
+
+#define size (SIZEOF(xPolyFillRectangleReq) + FRCTSPERBATCH * SIZEOF(xRectangle))
+
 int
 XFillRectangles(dpy, d, gc, rectangles, n_rects)
 register Display *dpy;
@@ -42,6 +46,14 @@ int n_rects;
 
     LockDisplay(dpy);
     FlushGC(dpy, gc);
+    len = ((long)n_rects) * SIZEOF(xRectangle);
+    /* if same as previous request, with same drawable, batch requests */
+    if (n_rects &&
+	_XExtendPolyRequest(dpy, X_PolyFillRectangle, d, gc, len,
+			    size)) {
+	Data16 (dpy, (short *) rectangles, len);
+	n_rects = 0;
+    }
     while (n_rects) {
 	GetReq(PolyFillRectangle, req);
 	req->drawable = d;
@@ -56,3 +56,49 @@ Status XGetGeometry (dpy, d, root, x, y, width, height, borderWidth, depth)
     return (1);
 }
 
+
+XReplyCookie XGetGeometryCookie (dpy, d)
+    register Display *dpy;
+    Drawable d;
+{
+    XReplyCookie cookie;
+    register xResourceReq *req;
+
+    if (!(cookie = _XAllocReplyCookie((XPointer)NULL)))
+	return NULL;
+    LockDisplay(dpy);
+    GetResReq(GetGeometry, d, req);
+    _XQueueReplyCookie(dpy, cookie);
+    UnlockDisplay(dpy);
+    SyncHandle();
+    return cookie;
+}
+
+Status XGetGeometryReply (dpy, cookie, root, x, y, width, height, borderWidth,
+			  depth)
+    register Display *dpy;
+    XReplyCookie cookie;
+    Window *root; /* RETURN */
+    int *x, *y;  /* RETURN */
+    unsigned int *width, *height, *borderWidth, *depth;  /* RETURN */
+{
+    xGetGeometryReply *rep;
+    Status status = 0;
+
+    if (!cookie)
+	return 0;
+    LockDisplay(dpy);
+    if ((rep = (xGetGeometryReply *)_XWaitReplyCookie(dpy, cookie))) {
+	*root = rep->root;
+	*x = cvtINT16toInt (rep->x);
+	*y = cvtINT16toInt (rep->y);
+	*width = rep->width;
+	*height = rep->height;
+	*borderWidth = rep->borderWidth;
+	*depth = rep->depth;
+	status = 1;
+    }
+    _XFreeReplyCookie(cookie);
+    UnlockDisplay(dpy);
+    return status;
+}
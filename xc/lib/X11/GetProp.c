@@ -131,3 +131,111 @@ XGetWindowProperty(dpy, w, property, offset, length, delete,
     return(Success);
 }
 
+
+XReplyCookie
+XGetWindowPropertyCookie(dpy, w, property, offset, length, delete, req_type)
+    register Display *dpy;
+    Window w;
+    Atom property;
+    long offset, length;
+    Bool delete;
+    Atom req_type;
+{
+    XReplyCookie cookie;
+    register xGetPropertyReq *req;
+
+    if (!(cookie = _XAllocReplyCookie((XPointer)NULL)))
+	return NULL;
+    LockDisplay(dpy);
+    GetReq (GetProperty, req);
+    req->window = w;
+    req->property = property;
+    req->type = req_type;
+    req->delete = delete;
+    req->longOffset = offset;
+    req->longLength = length;
+    _XQueueReplyCookie(dpy, cookie);
+    UnlockDisplay(dpy);
+    SyncHandle();
+    return cookie;
+}
+
+int
+XGetWindowPropertyReply(dpy, cookie, actual_type, actual_format, nitems,
+	bytesafter, prop)
+    register Display *dpy;
+    XReplyCookie cookie;
+    Atom *actual_type;		/* RETURN */
+    int *actual_format;  	/* RETURN  8, 16, or 32 */
+    unsigned long *nitems; 	/* RETURN  # of 8-, 16-, or 32-bit entities */
+    unsigned long *bytesafter;	/* RETURN */
+    unsigned char **prop;	/* RETURN */
+{
+    xGetPropertyReply *reply;
+    char *data;
+    register unsigned long i;
+    int status = 1;		/* not Success */
+
+    *prop = (unsigned char *) NULL;
+    if (!cookie)
+	return (1);
+    LockDisplay(dpy);
+    if (!(reply = (xGetPropertyReply *)_XWaitReplyCookie(dpy, cookie)))
+	goto done;
+    data = cookie->reply + SIZEOF(xGetPropertyReply);
+    if (reply->propertyType != None) {
+	/* the items must fit in the reply the handler stored */
+	if ((reply->format == 8 || reply->format == 16 ||
+	     reply->format == 32) &&
+	    reply->nItems > ((unsigned long) reply->length << 2) /
+			    (reply->format >> 3)) {
+	    status = BadImplementation;
+	    goto done;
+	}
+	/* one extra byte, null terminated, as in XGetWindowProperty */
+	switch (reply->format) {
+	  case 8:
+	    if ((*prop = (unsigned char *) Xmalloc ((unsigned)reply->nItems + 1))) {
+		memcpy((char *) *prop, data, reply->nItems);
+		(*prop)[reply->nItems] = '\0';
+	    }
+	    break;
+
+	  case 16:
+	    if ((*prop = (unsigned char *)
+		 Xmalloc ((unsigned)reply->nItems * sizeof (short) + 1))) {
+		for (i = 0; i < reply->nItems; i++)
+		    ((short *) *prop)[i] = ((CARD16 *) data)[i];
+		(*prop)[reply->nItems * sizeof (short)] = '\0';
+	    }
+	    break;
+
+	  case 32:
+	    if ((*prop = (unsigned char *)
+		 Xmalloc ((unsigned)reply->nItems * sizeof (long) + 1))) {
+		for (i = 0; i < reply->nItems; i++)
+		    ((long *) *prop)[i] = ((INT32 *) data)[i];
+		(*prop)[reply->nItems * sizeof (long)] = '\0';
+	    }
+	    break;
+
+	  default:
+	    /* the server sent a property with an invalid format */
+	    status = BadImplementation;
+	    goto done;
+	}
+	if (! *prop) {
+	    status = BadAlloc;
+	    goto done;
+	}
+    }
+    *actual_type = reply->propertyType;
+    *actual_format = reply->format;
+    *nitems = reply->nItems;
+    *bytesafter = reply->bytesAfter;
+    status = Success;
+  done:
+    _XFreeReplyCookie(cookie);
+    UnlockDisplay(dpy);
+    return (status);
+}
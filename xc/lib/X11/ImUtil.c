@@ -829,6 +829,39 @@ static int _XPutPixel1 (ximage, x, y, pixel)
  *
  */
 
+/*
+ * Z images with the same whole-byte pixel size, byte order and depth
+ * hold their pixels in identical form, so a rectangle moves between
+ * them a scanline at a time instead of a pixel at a time.
+ */
+#define SameZFormat(src, dst) \
+	((src)->format == ZPixmap && (dst)->format == ZPixmap && \
+	 (src)->bits_per_pixel == (dst)->bits_per_pixel && \
+	 ((src)->bits_per_pixel == 8 || (src)->bits_per_pixel == 16 || \
+	  (src)->bits_per_pixel == 32) && \
+	 (src)->byte_order == (dst)->byte_order && \
+	 (src)->depth == (dst)->depth)
+
+static void _XCopyZRows (src, sx, sy, dst, dx, dy, width, height)
+    XImage *src;
+    int sx, sy;
+    XImage *dst;
+    int dx, dy;
+    unsigned int width, height;
+{
+	register char *sp, *dp;
+	register int bpp = src->bits_per_pixel >> 3;
+	register unsigned int len = width * bpp;
+
+	sp = src->data + sy * src->bytes_per_line + sx * bpp;
+	dp = dst->data + dy * dst->bytes_per_line + dx * bpp;
+	while (height--) {
+	    memcpy(dp, sp, len);
+	    sp += src->bytes_per_line;
+	    dp += dst->bytes_per_line;
+	}
+}
+
 static XImage *_XSubImage (ximage, x, y, width, height)
     XImage *ximage;
     register int x;	/* starting x coordinate in existing image */
@@ -884,6 +917,11 @@ static XImage *_XSubImage (ximage, x, y, width, height)
 	if (height > ximage->height - y ) height = ximage->height - y;
 	if (width > ximage->width - x ) width = ximage->width - x;
 
+	if (SameZFormat(ximage, subimage) && x >= 0 && y >= 0 &&
+	    (int) width > 0 && (int) height > 0) {
+	    _XCopyZRows(ximage, x, y, subimage, 0, 0, width, height);
+	    return subimage;
+	}
 	for (row = y; row < (y + height); row++) {
 	    for (col = x; col < (x + width); col++) {
 		pixel = XGetPixel(ximage, col, row);
@@ -944,6 +982,13 @@ int _XSetImage (srcimg, dstimg, x, y)
 	if (srcimg->height < height)
 	    height = srcimg->height;
 
+	if (SameZFormat(srcimg, dstimg)) {
+	    if (width > startcol && height > startrow)
+		_XCopyZRows(srcimg, startcol, startrow, dstimg,
+			    x + startcol, y + startrow,
+			    width - startcol, height - startrow);
+	    return 1;
+	}
 	/* this is slow, will do better later */
 	for (row = startrow; row < height; row++) {
 	    for (col = startcol; col < width; col++) {
@@ -31,11 +31,177 @@ from The Open Group.
 #define NEED_REPLIES
 #include "Xlibint.h"
 #include "Xintatom.h"
+#include <X11/Xos.h>
+#include <stdio.h>
 
 #define HASH(sig) ((sig) & (TABLESIZE-1))
 #define REHASHVAL(sig) ((((sig) % (TABLESIZE-3)) + 2) | 1)
 #define REHASH(idx,rehash) ((idx + rehash) & (TABLESIZE-1))
 
+/*
+ * Persistent atom cache.  When XATOMCACHE names a file, the atom table
+ * is loaded from it the first time the display interns an atom and
+ * written back when the display is closed, so that clients started
+ * one after another against the same server do not intern the same
+ * atoms again.  Atoms only last as long as the server does, so the
+ * file records a sentinel: an atom with a name unique to that file.
+ * The file is used only if interning the sentinel name with
+ * only_if_exists still returns the recorded atom, which fails once
+ * the server has reset.  That costs one round trip; when it fails a
+ * new sentinel is interned and the file rewritten on close.
+ *
+ * The file is text: a header line "XAtomCache version release
+ * sentinel-atom sentinel-name", the display name, then one
+ * "atom name" line per entry.
+ */
+
+#define ATOM_CACHE_VERSION 1
+#define ATOM_CACHE_ENV "XATOMCACHE"
+
+/*
+ * A setuid or setgid client must not read or write a file the user
+ * named, so the cache is only used by unprivileged processes.
+ */
+static char *
+_XAtomCachePath()
+{
+    char *path;
+
+    if (getuid() != geteuid() || getgid() != getegid())
+	return NULL;
+    if (!(path = getenv(ATOM_CACHE_ENV)) || !*path)
+	return NULL;
+    return path;
+}
+
+static Atom
+_XInternAtomSync(dpy, name, onlyIfExists)
+    Display *dpy;
+    char *name;
+    Bool onlyIfExists;
+{
+    xInternAtomReq *req;
+    xInternAtomReply rep;
+    int n = strlen(name);
+
+    GetReq(InternAtom, req);
+    req->nbytes = n;
+    req->onlyIfExists = onlyIfExists;
+    req->length += (n+3)>>2;
+    Data(dpy, name, n);
+    if (!_XReply (dpy, (xReply *)&rep, 0, xTrue))
+	return None;
+    return rep.atom;
+}
+
+static void
+_XLoadAtomCache(dpy)
+    Display *dpy;
+{
+    AtomTable *atoms = dpy->atoms;
+    char *path, *name, *nl;
+    char line[BUFSIZ];
+    char sentinel_name[256];
+    unsigned long release, sentinel, atom;
+    int version;
+    FILE *fp;
+
+    atoms->cache_loaded = True;
+    if (!(path = _XAtomCachePath()))
+	return;
+    if ((fp = fopen(path, "r"))) {
+	if (fgets(line, sizeof(line), fp) &&
+	    sscanf(line, "XAtomCache %d %lu %lu %255s", &version, &release,
+		   &sentinel, sentinel_name) == 4 &&
+	    version == ATOM_CACHE_VERSION &&
+	    release == (unsigned long)dpy->release &&
+	    fgets(line, sizeof(line), fp) &&
+	    (nl = strchr(line, '\n')) && (*nl = '\0', 1) &&
+	    dpy->display_name && !strcmp(line, dpy->display_name) &&
+	    sentinel != None &&
+	    _XInternAtomSync(dpy, sentinel_name, True) == sentinel &&
+	    (atoms->sentinel_name = Xmalloc(strlen(sentinel_name) + 1))) {
+	    strcpy(atoms->sentinel_name, sentinel_name);
+	    atoms->sentinel = sentinel;
+	    while (fgets(line, sizeof(line), fp)) {
+		/* names too long for the buffer are skipped */
+		if (!(nl = strchr(line, '\n'))) {
+		    while (fgets(line, sizeof(line), fp) &&
+			   !strchr(line, '\n'))
+			;
+		    continue;
+		}
+		*nl = '\0';
+		atom = strtoul(line, &name, 10);
+		if (atom != None && *name == ' ' && name[1])
+		    _XUpdateAtomCache(dpy, name + 1, (Atom)atom,
+				      (unsigned long)0, -1, 0);
+	    }
+	    atoms->dirty = False;
+	}
+	fclose(fp);
+    }
+    if (!atoms->sentinel) {
+	/* no usable file: start a new one */
+	sprintf(sentinel_name, "_XLIB_ATOM_CACHE_%lx_%lx",
+		(unsigned long)time((time_t *)NULL), (unsigned long)getpid());
+	if ((atoms->sentinel_name = Xmalloc(strlen(sentinel_name) + 1))) {
+	    strcpy(atoms->sentinel_name, sentinel_name);
+	    atoms->sentinel = _XInternAtomSync(dpy, sentinel_name, False);
+	    atoms->dirty = True;
+	}
+    }
+}
+
+static void
+_XSaveAtomCache(dpy)
+    Display *dpy;
+{
+    AtomTable *atoms = dpy->atoms;
+    char *path, *tmp;
+    register int i;
+    register Entry e;
+    FILE *fp;
+    int fd;
+
+    if (!(path = _XAtomCachePath()) || !dpy->display_name)
+	return;
+    if (!(tmp = Xmalloc(strlen(path) + 20)))
+	return;
+    /*
+     * Write a private copy and rename it, other clients may be reading.
+     * The copy is created exclusively, never through an existing file
+     * or symbolic link.
+     */
+    sprintf(tmp, "%s.%lx", path, (unsigned long)getpid());
+#ifdef O_NOFOLLOW
+    fd = open(tmp, O_WRONLY | O_CREAT | O_EXCL | O_NOFOLLOW, 0600);
+#else
+    fd = open(tmp, O_WRONLY | O_CREAT | O_EXCL, 0600);
+#endif
+    if (fd < 0) {
+	Xfree(tmp);
+	return;
+    }
+    if (!(fp = fdopen(fd, "w"))) {
+	close(fd);
+	unlink(tmp);
+    } else {
+	fprintf(fp, "XAtomCache %d %lu %lu %s\n", ATOM_CACHE_VERSION,
+		(unsigned long)dpy->release, (unsigned long)atoms->sentinel,
+		atoms->sentinel_name);
+	fprintf(fp, "%s\n", dpy->display_name);
+	for (i = 0; i < TABLESIZE; i++) {
+	    if ((e = atoms->table[i]) && (e != RESERVED) &&
+		!strchr(EntryName(e), '\n'))
+		fprintf(fp, "%lu %s\n", (unsigned long)e->atom, EntryName(e));
+	}
+	if (fclose(fp) != 0 || rename(tmp, path) != 0)
+	    unlink(tmp);
+    }
+    Xfree(tmp);
+}
+
 void
 _XFreeAtomTable(dpy)
     Display *dpy;
@@ -45,15 +211,33 @@ _XFreeAtomTable(dpy)
     register Entry e;
 
     if (dpy->atoms) {
+	if (dpy->atoms->dirty && dpy->atoms->sentinel)
+	    _XSaveAtomCache(dpy);
 	table = dpy->atoms->table;
 	for (i = TABLESIZE; --i >= 0; ) {
 	    if ((e = *table++) && (e != RESERVED))
 		Xfree((char *)e);
 	}
+	if (dpy->atoms->sentinel_name)
+	    Xfree(dpy->atoms->sentinel_name);
 	Xfree((char *)dpy->atoms);
     }
 }
 
+/* the display's atom table, created and loaded on first use */
+static AtomTable *
+_XAtomTable(dpy)
+    Display *dpy;
+{
+    if (!dpy->atoms) {
+	dpy->atoms = (AtomTable *)Xcalloc(1, sizeof(AtomTable));
+	dpy->free_funcs->atoms = _XFreeAtomTable;
+    }
+    if (dpy->atoms && !dpy->atoms->cache_loaded)
+	_XLoadAtomCache(dpy);
+    return dpy->atoms;
+}
+
 static
 Atom _XInternAtom(
     Display *dpy,
@@ -72,10 +256,7 @@ Atom _XInternAtom(
     xInternAtomReq *req;
 
     /* look in the cache first */
-    if (!(atoms = dpy->atoms)) {
-	dpy->atoms = atoms = (AtomTable *)Xcalloc(1, sizeof(AtomTable));
-	dpy->free_funcs->atoms = _XFreeAtomTable;
-    }
+    atoms = _XAtomTable(dpy);
     sig = 0;
     for (s1 = (char *)name; (c = *s1++); )
 	sig += c;
@@ -156,6 +337,7 @@ _XUpdateAtomCache(dpy, name, atom, sig, idx, n)
 	if ((oe = dpy->atoms->table[idx]) && (oe != RESERVED))
 	    Xfree((char *)oe);
 	dpy->atoms->table[idx] = e;
+	dpy->atoms->dirty = True;
     }
 }
 
@@ -199,6 +381,7 @@ typedef struct {
     unsigned long stop_seq;
     char **names;
     Atom *atoms;
+    int idx;			/* replies come in order, resume here */
     int count;
     Status status;
 } _XIntAtomState;
@@ -220,7 +403,7 @@ Bool _XIntAtomHandler(
     if (dpy->last_request_read < state->start_seq ||
 	dpy->last_request_read > state->stop_seq)
 	return False;
-    for (i = 0; i < state->count; i++) {
+    for (i = state->idx; i < state->count; i++) {
 	if (state->atoms[i] & 0x80000000) {
 	    idx = ~state->atoms[i];
 	    state->atoms[i] = None;
@@ -229,6 +412,7 @@ Bool _XIntAtomHandler(
     }
     if (i >= state->count)
 	return False;
+    state->idx = i + 1;
     if (rep->generic.type == X_Error) {
 	state->status = 0;
 	return False;
@@ -259,9 +443,12 @@ XInternAtoms (dpy, names, count, onlyIfExists, atoms_return)
     xInternAtomReply rep;
 
     LockDisplay(dpy);
+    /* any round trip for the persistent cache goes before the batch */
+    (void) _XAtomTable(dpy);
     async_state.start_seq = dpy->request + 1;
     async_state.atoms = atoms_return;
     async_state.names = names;
+    async_state.idx = 0;
     async_state.count = count - 1;
     async_state.status = 1;
     async.next = dpy->async_handlers;
@@ -302,3 +489,77 @@ XInternAtoms (dpy, names, count, onlyIfExists, atoms_return)
 	SyncHandle();
     return async_state.status;
 }
+
+#if NeedFunctionPrototypes
+XReplyCookie XInternAtomCookie (
+    Display *dpy,
+    _Xconst char *name,
+    Bool onlyIfExists)
+#else
+XReplyCookie XInternAtomCookie (dpy, name, onlyIfExists)
+    Display *dpy;
+    char *name;
+    Bool onlyIfExists;
+#endif
+{
+    XReplyCookie cookie;
+    Atom atom;
+    unsigned long sig;
+    int idx, n;
+    char *copy;
+
+    if (!name)
+	name = "";
+    if (!(copy = Xmalloc(strlen(name) + 1)))
+	return NULL;
+    strcpy(copy, name);
+    if (!(cookie = _XAllocReplyCookie((XPointer)copy))) {
+	Xfree(copy);
+	return NULL;
+    }
+    LockDisplay(dpy);
+    if ((atom = _XInternAtom(dpy, name, onlyIfExists, &sig, &idx, &n))) {
+	/* found in the cache, no request was sent */
+	if ((cookie->reply = Xcalloc(1, SIZEOF(xInternAtomReply)))) {
+	    ((xInternAtomReply *)cookie->reply)->atom = atom;
+	    cookie->state = ReplyCookieReplied;
+	} else {
+	    cookie->error.type = X_Error;
+	    cookie->error.errorCode = BadAlloc;
+	    cookie->state = ReplyCookieFailed;
+	}
+	UnlockDisplay(dpy);
+	return cookie;
+    }
+    if (dpy->atoms && dpy->atoms->table[idx] == RESERVED)
+	dpy->atoms->table[idx] = NULL; /* unreserve slot */
+    _XQueueReplyCookie(dpy, cookie);
+    UnlockDisplay(dpy);
+    SyncHandle();
+    return cookie;
+}
+
+Status
+XInternAtomReply (dpy, cookie, atom_return)
+    Display *dpy;
+    XReplyCookie cookie;
+    Atom *atom_return;
+{
+    xInternAtomReply *rep;
+    Status status = 0;
+
+    *atom_return = None;
+    if (!cookie)
+	return 0;
+    LockDisplay(dpy);
+    if ((rep = (xInternAtomReply *)_XWaitReplyCookie(dpy, cookie))) {
+	/* cookies answered from the cache have no sequence number */
+	if ((*atom_return = rep->atom) && cookie->sequence)
+	    _XUpdateAtomCache(dpy, (char *)cookie->closure, *atom_return,
+			      (unsigned long)0, -1, 0);
+	status = 1;
+    }
+    _XFreeReplyCookie(cookie);
+    UnlockDisplay(dpy);
+    return status;
+}
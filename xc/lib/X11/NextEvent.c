@@ -52,3 +52,32 @@ XNextEvent (dpy, event)
 	return 0;
 }
 
+/*
+ * Copy up to count events from the head of the queue into the array,
+ * waiting as XNextEvent does if the queue is empty.  Returns the
+ * number of events copied.
+ */
+
+int
+XNextEvents (dpy, events, count)
+	register Display *dpy;
+	register XEvent *events;
+	int count;
+{
+	register _XQEvent *qelt;
+	register int n;
+
+	if (count <= 0)
+	    return 0;
+	LockDisplay(dpy);
+
+	if (dpy->head == NULL)
+	    _XReadEvents(dpy);
+	for (n = 0; n < count && (qelt = dpy->head); n++) {
+	    events[n] = qelt->event;
+	    _XDeq(dpy, NULL, qelt);
+	}
+	UnlockDisplay(dpy);
+	return n;
+}
+
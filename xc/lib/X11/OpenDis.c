@@ -221,6 +221,7 @@ Display *XOpenDisplay (display)
 	dpy->flushes		= NULL;
 	dpy->xcmisc_opcode	= 0;
 	dpy->xkb_info		= NULL;
+	dpy->compress_mask	= 0;
 
 /*
  * Setup other information in this display structure.
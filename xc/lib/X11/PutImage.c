@@ -126,6 +126,20 @@ _XReverse_Bytes (bpt, nb)
 }
 
 
+/*
+ * When a scanline and its destination are both word aligned the swaps
+ * below move a CARD32 at a time; the byte loops pick up whatever is
+ * left of the line.
+ */
+#ifndef WORD64
+#define WordAligned(src, dest) \
+    (!(((unsigned long)(src) | (unsigned long)(dest)) & 3))
+#define SwapShorts32(w) ((((w) & 0x00ff00ff) << 8) | (((w) >> 8) & 0x00ff00ff))
+#define SwapBytes32(w) \
+    (((w) << 24) | (((w) & 0xff00) << 8) | (((w) >> 8) & 0xff00) | ((w) >> 24))
+#define SwapHalves32(w) (((w) << 16) | ((w) >> 16))
+#endif
+
 /* XXX the following functions are declared int instead of void because various
  * compilers and lints complain about later initialization of SwapFunc and/or
  * (swapfunc == NoSwap) when void is used.
@@ -168,7 +182,15 @@ SwapTwoBytes (src, dest, srclen, srcinc, destinc, height, half_order)
 	    else
 		*(dest + length + 1) = *(src + length);
 	}
-	for (n = length; n > 0; n -= 2, src += 2) {
+	n = length;
+#ifndef WORD64
+	if (WordAligned(src, dest))
+	    for (; n >= 4; n -= 4, src += 4, dest += 4) {
+		register CARD32 w = *(CARD32 *)src;
+		*(CARD32 *)dest = SwapShorts32(w);
+	    }
+#endif
+	for (; n > 0; n -= 2, src += 2) {
 	    *dest++ = *(src + 1);
 	    *dest++ = *src;
 	}
@@ -231,7 +253,15 @@ SwapFourBytes (src, dest, srclen, srcinc, destinc, height, half_order)
 	    if (half_order == LSBFirst)
 		*(dest + length + 3) = *(src + length);
 	}
-	for (n = length; n > 0; n -= 4, src += 4) {
+	n = length;
+#ifndef WORD64
+	if (WordAligned(src, dest))
+	    for (; n > 0; n -= 4, src += 4, dest += 4) {
+		register CARD32 w = *(CARD32 *)src;
+		*(CARD32 *)dest = SwapBytes32(w);
+	    }
+#endif
+	for (; n > 0; n -= 4, src += 4) {
 	    *dest++ = *(src + 3);
 	    *dest++ = *(src + 2);
 	    *dest++ = *(src + 1);
@@ -266,7 +296,15 @@ SwapWords (src, dest, srclen, srcinc, destinc, height, half_order)
 	    if (half_order == LSBFirst)
 		*(dest + length + 2) = *(src + length);
 	}
-	for (n = length; n > 0; n -= 4, src += 2) {
+	n = length;
+#ifndef WORD64
+	if (WordAligned(src, dest))
+	    for (; n > 0; n -= 4, src += 4, dest += 4) {
+		register CARD32 w = *(CARD32 *)src;
+		*(CARD32 *)dest = SwapHalves32(w);
+	    }
+#endif
+	for (; n > 0; n -= 4, src += 2) {
 	    *dest++ = *(src + 2);
 	    *dest++ = *(src + 3);
 	    *dest++ = *src++;
@@ -945,6 +983,12 @@ XPutImage (dpy, d, gc, image, req_xoffset, req_yoffset, x, y, req_width,
     if ((width <= 0) || (height <= 0))
 	return 0;
 
+    /* images made by XShmCreateSharedImage go through shared memory */
+    if (image->obdata && _XPutImageShmFunc &&
+	(*_XPutImageShmFunc)(dpy, d, gc, image, req_xoffset, req_yoffset,
+			     x, y, (unsigned int) width, (unsigned int) height))
+	return 0;
+
     if ((image->bits_per_pixel == 1) || (image->format != ZPixmap)) {
 	dest_bits_per_pixel = 1;
 	dest_scanline_pad = dpy->bitmap_pad;
@@ -70,3 +70,59 @@ Status XQueryTree (dpy, w, root, parent, children, nchildren)
     return (1);
 }
 
+
+XReplyCookie XQueryTreeCookie (dpy, w)
+    register Display *dpy;
+    Window w;
+{
+    XReplyCookie cookie;
+    register xResourceReq *req;
+
+    if (!(cookie = _XAllocReplyCookie((XPointer)NULL)))
+	return NULL;
+    LockDisplay(dpy);
+    GetResReq(QueryTree, w, req);
+    _XQueueReplyCookie(dpy, cookie);
+    UnlockDisplay(dpy);
+    SyncHandle();
+    return cookie;
+}
+
+Status XQueryTreeReply (dpy, cookie, root, parent, children, nchildren)
+    register Display *dpy;
+    XReplyCookie cookie;
+    Window *root;	/* RETURN */
+    Window *parent;	/* RETURN */
+    Window **children;	/* RETURN */
+    unsigned int *nchildren;  /* RETURN */
+{
+    xQueryTreeReply *rep;
+    register CARD32 *wire;
+    register unsigned int i;
+    Status status = 0;
+
+    if (!cookie)
+	return 0;
+    LockDisplay(dpy);
+    if ((rep = (xQueryTreeReply *)_XWaitReplyCookie(dpy, cookie))) {
+	*children = (Window *) NULL;
+	if (rep->nChildren != 0) {
+	    *children = (Window *)
+		Xmalloc((unsigned) rep->nChildren * sizeof(Window));
+	    if (*children) {
+		wire = (CARD32 *)(cookie->reply + SIZEOF(xQueryTreeReply));
+		for (i = 0; i < rep->nChildren; i++)
+		    (*children)[i] = wire[i];
+	    }
+	}
+	if (*children || !rep->nChildren) {
+	    *parent = rep->parent;
+	    *root = rep->root;
+	    *nchildren = rep->nChildren;
+	    status = 1;
+	}
+    }
+    _XFreeReplyCookie(cookie);
+    UnlockDisplay(dpy);
+    return status;
+}
@@ -113,6 +113,7 @@ EXPORTS
  XDestroyWindow
  XDirectionalDependentDrawing
  XDisableAccessControl
+ XDiscardReplyCookie
  XDisplayCells
  XDisplayHeight
  XDisplayHeightMM
@@ -207,6 +208,8 @@ EXPORTS
  XGetFontProperty
  XGetGCValues
  XGetGeometry
+ XGetGeometryCookie
+ XGetGeometryReply
  XGetICValues
  XGetIMValues
  XGetIconName
@@ -242,6 +245,8 @@ EXPORTS
  XGetWMSizeHints
  XGetWindowAttributes
  XGetWindowProperty
+ XGetWindowPropertyCookie
+ XGetWindowPropertyReply
  XGetZoomHints
  XGrabButton
  XGrabKey
@@ -260,6 +265,8 @@ EXPORTS
  XInsertModifiermapEntry
  XInstallColormap
  XInternAtom
+ XInternAtomCookie
+ XInternAtomReply
  XInternAtoms
  XInternalConnectionNumbers
  XIntersectRegion
@@ -298,6 +305,7 @@ EXPORTS
  XMoveWindow
  XNewModifiermap
  XNextEvent
+ XNextEvents
  XNextRequest
  XNoOp
  XOMOfOC
@@ -333,6 +341,8 @@ EXPORTS
  XQueryTextExtents
  XQueryTextExtents16
  XQueryTree
+ XQueryTreeCookie
+ XQueryTreeReply
  XRaiseWindow
  XReadBitmapFile
  XReadBitmapFileData
@@ -347,6 +357,7 @@ EXPORTS
  XRemoveHost
  XRemoveHosts
  XReparentWindow
+ XReplyCookieError
  XResetScreenSaver
  XResizeWindow
  XResourceManagerString
@@ -376,6 +387,7 @@ EXPORTS
  XSetCommand
  XSetDashes
  XSetErrorHandler
+ XSetEventCompression
  XSetFillRule
  XSetFillStyle
  XSetFont
@@ -598,6 +610,7 @@ EXPORTS
  XwcTextPropertyToTextList
  _XAllocID
  _XAllocIDs
+ _XAllocReplyCookie
  _XAllocScratch
  _XAllocTemp
  _XAsyncErrorHandler
@@ -605,15 +618,18 @@ EXPORTS
  _XDeqAsyncHandler
  _XEatData
  _XError
+ _XExtendPolyRequest
 #ifndef __UNIXOS2__
  _XFlushIt
 #endif
  _XFlushGCCache
+ _XFreeReplyCookie
  _XFreeTemp
  _XGetAsyncData
  _XGetAsyncReply
  _XIOError
  _XInitImageFuncPtrs
+ _XQueueReplyCookie
  _XRead
 ;_XReadEvents
  _XReadPad
@@ -627,6 +643,7 @@ EXPORTS
  _XUnregisterFilter
  _XUnregisterInternalConnection
  _XVIDtoVisual
+ _XWaitReplyCookie
 #ifndef __UNIXOS2__
  _Xthread_init
  _Xthread_waiter
@@ -904,6 +921,7 @@ EXPORTS
 	XGetErrorText   
 	XGetErrorDatabaseText   
 	XSetErrorHandler   
+	XSetEventCompression   
 	XSetIOErrorHandler   
 	_XEventToWire   
 	XFetchName   
@@ -1091,6 +1109,7 @@ EXPORTS
 	XDeleteModifiermapEntry   
 	XMoveWindow   
 	XNextEvent   
+	XNextEvents   
 	XOpenDisplay   
 	_XFreeDisplayStructure   
 	XParseColor   
@@ -1235,6 +1254,7 @@ EXPORTS
 	_XError   
 	_XIOError   
 	_XAllocScratch   
+	_XExtendPolyRequest   
 	_XVIDtoVisual   
 	XFree   
 	_XGetHostname   
@@ -1498,6 +1518,20 @@ EXPORTS
 	XProcessInternalConnection   
 	XAddConnectionWatch   
 	XRemoveConnectionWatch   
+	_XAllocReplyCookie   
+	_XQueueReplyCookie   
+	_XWaitReplyCookie   
+	_XFreeReplyCookie   
+	XDiscardReplyCookie   
+	XGetGeometryCookie   
+	XGetGeometryReply   
+	XGetWindowPropertyCookie   
+	XGetWindowPropertyReply   
+	XInternAtomCookie   
+	XInternAtomReply   
+	XQueryTreeCookie   
+	XQueryTreeReply   
+	XReplyCookieError   
 	_XDeq   
 	_XcmsCIEXYZ_ValidSpec   
 	_XcmsCIEuvY_ValidSpec   
@@ -1952,6 +1986,7 @@ EXPORTS
 	_XkeyTable  
 	_Xevent_to_mask  
 	_qfree  
+	_XPutImageShmFunc  
 	_XIOErrorFunction  
 	_XErrorFunction  
 	_XHeadOfDisplayList  
@@ -7,7 +7,7 @@
 
 /* IntAtom.c */
 
-#define TABLESIZE 64
+#define TABLESIZE 512
 
 typedef struct _Entry {
     unsigned long sig;
@@ -20,6 +20,11 @@ typedef struct _Entry {
 
 typedef struct _XDisplayAtoms {
     Entry table[TABLESIZE];
+    /* persistent cache, see IntAtom.c */
+    Bool cache_loaded;		/* $XATOMCACHE has been looked at */
+    Bool dirty;			/* entries learned since then */
+    Atom sentinel;		/* atom that validates the cache file */
+    char *sentinel_name;
 } AtomTable;
 
 _XFUNCPROTOBEGIN
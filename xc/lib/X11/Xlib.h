@@ -3329,6 +3329,21 @@ extern int XNextEvent(
 #endif
 );
 
+extern int XNextEvents(
+#if NeedFunctionPrototypes
+    Display*		/* display */,
+    XEvent*		/* events_return */,
+    int			/* count */
+#endif
+);
+
+extern long XSetEventCompression(
+#if NeedFunctionPrototypes
+    Display*		/* display */,
+    long		/* event_mask */
+#endif
+);
+
 extern int XNoOp(
 #if NeedFunctionPrototypes
     Display*		/* display */
@@ -4818,6 +4833,102 @@ extern void XSetAuthorization(
 #endif
 );
 
+typedef struct _XReplyCookie *XReplyCookie;
+
+extern XReplyCookie XInternAtomCookie(
+#if NeedFunctionPrototypes
+    Display*			/* dpy */,
+    _Xconst char*		/* atom_name */,
+    Bool			/* only_if_exists */
+#endif
+);
+
+extern Status XInternAtomReply(
+#if NeedFunctionPrototypes
+    Display*			/* dpy */,
+    XReplyCookie		/* cookie */,
+    Atom*			/* atom_return */
+#endif
+);
+
+extern XReplyCookie XGetWindowPropertyCookie(
+#if NeedFunctionPrototypes
+    Display*			/* dpy */,
+    Window			/* w */,
+    Atom			/* property */,
+    long			/* long_offset */,
+    long			/* long_length */,
+    Bool			/* delete */,
+    Atom			/* req_type */
+#endif
+);
+
+extern int XGetWindowPropertyReply(
+#if NeedFunctionPrototypes
+    Display*			/* dpy */,
+    XReplyCookie		/* cookie */,
+    Atom*			/* actual_type_return */,
+    int*			/* actual_format_return */,
+    unsigned long*		/* nitems_return */,
+    unsigned long*		/* bytes_after_return */,
+    unsigned char**		/* prop_return */
+#endif
+);
+
+extern XReplyCookie XQueryTreeCookie(
+#if NeedFunctionPrototypes
+    Display*			/* dpy */,
+    Window			/* w */
+#endif
+);
+
+extern Status XQueryTreeReply(
+#if NeedFunctionPrototypes
+    Display*			/* dpy */,
+    XReplyCookie		/* cookie */,
+    Window*			/* root_return */,
+    Window*			/* parent_return */,
+    Window**			/* children_return */,
+    unsigned int*		/* nchildren_return */
+#endif
+);
+
+extern XReplyCookie XGetGeometryCookie(
+#if NeedFunctionPrototypes
+    Display*			/* dpy */,
+    Drawable			/* d */
+#endif
+);
+
+extern Status XGetGeometryReply(
+#if NeedFunctionPrototypes
+    Display*			/* dpy */,
+    XReplyCookie		/* cookie */,
+    Window*			/* root_return */,
+    int*			/* x_return */,
+    int*			/* y_return */,
+    unsigned int*		/* width_return */,
+    unsigned int*		/* height_return */,
+    unsigned int*		/* border_width_return */,
+    unsigned int*		/* depth_return */
+#endif
+);
+
+extern Bool XReplyCookieError(
+#if NeedFunctionPrototypes
+    Display*			/* dpy */,
+    XReplyCookie		/* cookie */,
+    XErrorEvent*		/* error_return */
+#endif
+);
+
+extern void XDiscardReplyCookie(
+#if NeedFunctionPrototypes
+    Display*			/* dpy */,
+    XReplyCookie		/* cookie */
+#endif
+);
+
 extern int _Xmbtowc(
 #if NeedFunctionPrototypes
     wchar_t *			/* wstr */,
@@ -330,11 +330,8 @@ _XWaitForWritable(dpy
 	if (FD_ISSET(dpy->fd, &w_mask))
 #endif
 	{
-#ifdef XTHREADS
-	    if (dpy->lock) {
-		ConditionBroadcast(dpy, dpy->lock->writers);
-	    }
-#endif
+	    /* threads waiting to flush are woken by the writer when it
+	       is done (see _XFlushInt), not each time the socket drains */
 	    return;
 	}
     }
@@ -580,6 +577,9 @@ static void _XFlushInt (dpy, cv)
 	register int write_stat;
 	register char *bufindex;
 	_XExtension *ext;
+#ifdef XTHREADS
+	Bool waited = False;
+#endif
 
 	/* This fix resets the bufptr to the front of the buffer so
 	 * additional appends to the bufptr will not corrupt memory. Since
@@ -594,16 +594,30 @@ static void _XFlushInt (dpy, cv)
 	}
 
 #ifdef XTHREADS
+	/*
+	 * Threads that find a write in progress queue on the writers
+	 * condition.  The writer signals it once when it is done, and
+	 * each waiter in turn passes the signal on if it has nothing to
+	 * write itself, so they are released one at a time rather than
+	 * all at once.
+	 */
 	while (dpy->flags & XlibDisplayWriting) {
 	    if (dpy->lock) {
 		ConditionWait(dpy, dpy->lock->writers);
+		waited = True;
 	    } else {
 		_XWaitForWritable (dpy, cv);
 	    }
 	}
 #endif
 	size = todo = dpy->bufptr - dpy->buffer;
-	if (!size) return;
+	if (!size) {
+#ifdef XTHREADS
+	    if (waited)
+		ConditionSignal(dpy, dpy->lock->writers);
+#endif
+	    return;
+	}
 #ifdef XTHREADS
 	dpy->flags |= XlibDisplayWriting;
 	/* make sure no one else can put in data */
@@ -667,6 +681,8 @@ static void _XFlushInt (dpy, cv)
 	dpy->bufptr = dpy->buffer;
 #ifdef XTHREADS
 	dpy->flags &= ~XlibDisplayWriting;
+	if (dpy->lock)
+	    ConditionSignal(dpy, dpy->lock->writers);
 #endif
 }
 
@@ -1433,6 +1449,8 @@ _XSend (dpy, data, size)
 	dpy->bufptr = dpy->buffer;
 #ifdef XTHREADS
 	dpy->flags &= ~XlibDisplayWriting;
+	if (dpy->lock)
+	    ConditionSignal(dpy, dpy->lock->writers);
 #endif
 	return;
 }
@@ -2231,10 +2249,58 @@ void _XEatData (dpy, n)
 }
 
 
+/*
+ * With XSetEventCompression, a MotionNotify replaces a MotionNotify for
+ * the same window at the tail of the queue, and an Expose is folded
+ * into an unfinished Expose series for the same window at the tail,
+ * the merged event covering the bounding box of both.
+ */
+static Bool
+_XCompressEvent(dpy, old, new)
+    register Display *dpy;
+    register XEvent *old;
+    register XEvent *new;
+{
+    int x1, y1, x2, y2;
+
+    if (old->type != new->type || old->xany.send_event ||
+	new->xany.send_event || old->xany.window != new->xany.window)
+	return False;
+    switch (new->type) {
+    case MotionNotify:
+	if (!(dpy->compress_mask & PointerMotionMask) ||
+	    old->xmotion.subwindow != new->xmotion.subwindow ||
+	    old->xmotion.state != new->xmotion.state ||
+	    old->xmotion.is_hint != new->xmotion.is_hint ||
+	    old->xmotion.same_screen != new->xmotion.same_screen)
+	    return False;
+	old->xmotion = new->xmotion;
+	return True;
+    case Expose:
+	if (!(dpy->compress_mask & ExposureMask) || !old->xexpose.count)
+	    return False;
+	x1 = min(old->xexpose.x, new->xexpose.x);
+	y1 = min(old->xexpose.y, new->xexpose.y);
+	x2 = max(old->xexpose.x + old->xexpose.width,
+		 new->xexpose.x + new->xexpose.width);
+	y2 = max(old->xexpose.y + old->xexpose.height,
+		 new->xexpose.y + new->xexpose.height);
+	old->xexpose.serial = new->xexpose.serial;
+	old->xexpose.x = x1;
+	old->xexpose.y = y1;
+	old->xexpose.width = x2 - x1;
+	old->xexpose.height = y2 - y1;
+	old->xexpose.count = new->xexpose.count;
+	return True;
+    }
+    return False;
+}
+
 /*
  * _XEnq - Place event packets on the display's queue.
  * note that no squishing of move events in V11, since there
- * is pointer motion hints....
+ * is pointer motion hints, unless the client asked for it
+ * with XSetEventCompression.
  */
 void _XEnq (dpy, event)
 	register Display *dpy;
@@ -2255,6 +2321,14 @@ void _XEnq (dpy, event)
 	qelt->next = NULL;
 	/* go call through display to find proper event reformatter */
 	if ((*dpy->event_vec[event->u.u.type & 0177])(dpy, &qelt->event, event)) {
+	    if (dpy->compress_mask && dpy->tail &&
+		_XCompressEvent(dpy, &dpy->tail->event, &qelt->event)) {
+		/* the tail changed; make it look new to waiting threads */
+		dpy->tail->qserial_num = dpy->next_event_serial_num++;
+		qelt->next = dpy->qfree;
+		dpy->qfree = qelt;
+		return;
+	    }
 	    qelt->qserial_num = dpy->next_event_serial_num++;
 	    if (dpy->tail)	dpy->tail->next = qelt;
 	    else 		dpy->head = qelt;
@@ -2928,6 +3002,33 @@ _XIOError (dpy)
 }
 
 
+/*
+ * Let a poly drawing call append to the last request in the buffer when
+ * that is the same kind of request for the same drawable and GC, as the
+ * single-primitive calls already do.  All the poly requests share the
+ * PolySegment layout.  Returns True with the request length bumped by
+ * nbytes if they fit in the buffer and keep the request within limit
+ * bytes; the caller then copies the data in with Data16.
+ */
+Bool
+_XExtendPolyRequest (dpy, type, d, gc, nbytes, limit)
+    register Display *dpy;
+    int type;
+    Drawable d;
+    GC gc;
+    long nbytes;
+    long limit;
+{
+    register xPolySegmentReq *req = (xPolySegmentReq *) dpy->last_req;
+
+    if (req->reqType != type || req->drawable != d || req->gc != gc->gid ||
+	dpy->bufptr + nbytes > dpy->bufmax ||
+	((char *)dpy->bufptr - (char *)req) + nbytes > limit)
+	return False;
+    req->length += nbytes >> 2;
+    return True;
+}
+
 /*
  * This routine can be used to (cheaply) get some memory within a single
  * Xlib routine for scratch space.  A single buffer is reused each time
@@ -187,6 +187,7 @@ struct _XDisplay
 	int xcmisc_opcode;	/* major opcode for XC-MISC */
 	struct _XkbInfoRec *xkb_info; /* XKB info */
 	struct _XtransConnInfo *trans_conn; /* transport connection object */
+	long compress_mask;	/* XSetEventCompression */
 };
 
 #define XAllocIDs(dpy,ids,n) (*(dpy)->idlist_alloc)(dpy,ids,n)
@@ -776,6 +777,30 @@ typedef struct _XAsyncEState {
     int error_count;
 } _XAsyncErrorState;
 
+/*
+ * A reply cookie stands for one request whose reply or error is picked
+ * up by an async handler and kept until the caller asks for it.
+ */
+struct _XReplyCookie {
+    _XAsyncHandler async;
+    unsigned long sequence;	/* request the cookie is waiting for */
+    int state;
+    char *reply;		/* whole reply, header included */
+    xError error;		/* error, when state is ReplyCookieFailed */
+    XPointer closure;		/* Xfree'd along with the cookie */
+};
+
+#define ReplyCookiePending	0
+#define ReplyCookieReplied	1
+#define ReplyCookieFailed	2
+#define ReplyCookieDiscarded	3
+
+extern XReplyCookie _XAllocReplyCookie(XPointer closure);
+extern void _XQueueReplyCookie(Display *dpy, XReplyCookie cookie);
+extern char *_XWaitReplyCookie(Display *dpy, XReplyCookie cookie);
+extern void _XFreeReplyCookie(XReplyCookie cookie);
+extern void _XFreeReplyCookies(Display *dpy);
+
 extern void _XDeqAsyncHandler(Display *dpy, _XAsyncHandler *handler);
 #define DeqAsyncHandler(dpy,handler) { \
     if (dpy->async_handlers == (handler)) \
@@ -951,6 +976,26 @@ extern int (*_XErrorFunction)(
     XErrorEvent*	/* error_event */
 #endif
 );
+
+/*
+ * Set by libXext: called by XPutImage for images with obdata, returns
+ * True if it has sent the image through shared memory.
+ */
+typedef Bool (*PutImageShmType)(
+#if NeedFunctionPrototypes
+    Display*		/* dpy */,
+    Drawable		/* d */,
+    GC			/* gc */,
+    XImage*		/* image */,
+    int			/* src_x */,
+    int			/* src_y */,
+    int			/* dst_x */,
+    int			/* dst_y */,
+    unsigned int	/* width */,
+    unsigned int	/* height */
+#endif
+);
+extern PutImageShmType _XPutImageShmFunc;
 extern void _XEatData(
 #if NeedFunctionPrototypes
     Display*		/* dpy */,
@@ -963,6 +1008,16 @@ extern char *_XAllocScratch(
     unsigned long	/* nbytes */
 #endif
 );
+extern Bool _XExtendPolyRequest(
+#if NeedFunctionPrototypes
+    Display*		/* dpy */,
+    int			/* type */,
+    Drawable		/* d */,
+    GC			/* gc */,
+    long		/* nbytes */,
+    long		/* limit */
+#endif
+);
 extern char *_XAllocTemp(
 #if NeedFunctionPrototypes
     Display*		/* dpy */,
@@ -177,6 +177,25 @@ typedef struct _LTable {
 
 #define LeafHash(le,q) (le)->buckets[(q) & (le)->table.mask]
 
+/* XrmQGetSearchList results are remembered per database, keyed by the
+ * complete name and class lists; Xt asks for the same lists over and
+ * over for widgets of the same name in the same parent.  Any change to
+ * the database empties the cache.
+ */
+#define SCACHESIZE 8
+
+typedef struct _SCacheEntry {
+    LTable		*list;		/* search list, NULL terminated */
+    int			length;		/* entries in list, with the NULL */
+    XrmQuark		*quarks;	/* names, then classes */
+    int			depth;		/* number of names */
+} SCacheEntryRec, *SCacheEntry;
+
+typedef struct _SCache {
+    int			next;		/* slot to reuse next */
+    SCacheEntryRec	entries[SCACHESIZE];
+} SCacheRec, *SCache;
+
 /* An XrmDatabase just holds a pointer to the first top-level table.
  * The type name is no longer descriptive, but better to not change
  * the Xresource.h header file.  This type also gets used to define
@@ -187,6 +206,7 @@ typedef struct _XrmHashBucketRec {
     NTable table;
     XPointer mbstate;
     XrmMethods methods;
+    SCache scache;
 #ifdef XTHREADS
     LockInfoRec linfo;
 #endif
@@ -490,6 +510,7 @@ static XrmDatabase NewDatabase()
 	_XCreateMutex(&db->linfo);
 	db->table = (NTable)NULL;
 	db->mbstate = (XPointer)NULL;
+	db->scache = (SCache)NULL;
 #ifdef _XP_PRINT_SERVER_
 	db->methods = NULL;
 #else
@@ -501,6 +522,82 @@ static XrmDatabase NewDatabase()
     return db;
 }
 
+static void FlushSearchCache(db)
+    XrmDatabase db;
+{
+    register SCache cache = db->scache;
+    register int i;
+
+    if (!cache)
+	return;
+    for (i = 0; i < SCACHESIZE; i++)
+	if (cache->entries[i].list)
+	    Xfree((char *)cache->entries[i].list);
+    Xfree((char *)cache);
+    db->scache = (SCache)NULL;
+}
+
+static SCacheEntry LookupSearchCache(db, names, classes, depth)
+    XrmDatabase		db;
+    XrmNameList		names;
+    XrmClassList	classes;
+    int			depth;
+{
+    register SCacheEntry entry;
+    register int i, j;
+
+    if (!db->scache)
+	return (SCacheEntry)NULL;
+    for (i = 0; i < SCACHESIZE; i++) {
+	entry = &db->scache->entries[i];
+	if (!entry->list || entry->depth != depth)
+	    continue;
+	for (j = 0; j < depth; j++)
+	    if (entry->quarks[j] != names[j] ||
+		entry->quarks[depth + j] != classes[j])
+		break;
+	if (j == depth)
+	    return entry;
+    }
+    return (SCacheEntry)NULL;
+}
+
+static void EnterSearchCache(db, names, classes, depth, list, length)
+    XrmDatabase		db;
+    XrmNameList		names;
+    XrmClassList	classes;
+    int			depth;
+    LTable		*list;
+    int			length;
+{
+    register SCache cache = db->scache;
+    register SCacheEntry entry;
+    LTable *block;
+
+    if (!cache) {
+	cache = (SCache)Xcalloc(1, sizeof(SCacheRec));
+	if (!cache)
+	    return;
+	db->scache = cache;
+    }
+    block = (LTable *)Xmalloc(length * sizeof(LTable) +
+			      2 * depth * sizeof(XrmQuark));
+    if (!block)
+	return;
+    entry = &cache->entries[cache->next];
+    cache->next = (cache->next + 1) % SCACHESIZE;
+    if (entry->list)
+	Xfree((char *)entry->list);
+    entry->list = block;
+    entry->length = length;
+    entry->quarks = (XrmQuark *)(block + length);
+    entry->depth = depth;
+    memcpy((char *)entry->list, (char *)list, length * sizeof(LTable));
+    memcpy((char *)entry->quarks, (char *)names, depth * sizeof(XrmQuark));
+    memcpy((char *)(entry->quarks + depth), (char *)classes,
+	   depth * sizeof(XrmQuark));
+}
+
 /* move all values from ftable to ttable, and free ftable's buckets.
  * ttable is quaranteed empty to start with.
  */
@@ -764,6 +861,8 @@ void XrmCombineDatabase(from, into, override)
     } else if (from) {
 	_XLockMutex(&from->linfo);
 	_XLockMutex(&(*into)->linfo);
+	FlushSearchCache(from);
+	FlushSearchCache(*into);
 	if ((ftable = from->table)) {
 	    prev = &(*into)->table;
 	    ttable = *prev;
@@ -822,6 +921,8 @@ static void PutEntry(db, bindings, quarks, type, value)
     register VEntry entry;
     NTable *nprev, *firstpprev;
 
+    FlushSearchCache(db);
+
 #define NEWTABLE(q,i) \
     table = (NTable)Xmalloc(sizeof(LTableRec)); \
     if (!table) \
@@ -2274,6 +2375,8 @@ Bool XrmQGetSearchList(db, names, classes, searchList, listLength)
 {
     register NTable	table;
     SClosureRec		closure;
+    SCacheEntry		cached;
+    int			depth;
 
     if (listLength <= 0)
 	return False;
@@ -2281,7 +2384,17 @@ Bool XrmQGetSearchList(db, names, classes, searchList, listLength)
     closure.idx = -1;
     closure.limit = listLength - 2;
     if (db) {
+	for (depth = 0; names[depth]; depth++)
+	    ;
 	_XLockMutex(&db->linfo);
+	if (depth <= MAXDBDEPTH &&
+	    (cached = LookupSearchCache(db, names, classes, depth)) &&
+	    cached->length <= listLength) {
+	    memcpy((char *)searchList, (char *)cached->list,
+		   cached->length * sizeof(LTable));
+	    _XUnlockMutex(&db->linfo);
+	    return True;
+	}
 	table = db->table;
 	if (*names) {
 	    if (table && !table->leaf) {
@@ -2304,6 +2417,10 @@ Bool XrmQGetSearchList(db, names, classes, searchList, listLength)
 		return False;
 	    }
 	}
+	closure.list[closure.idx + 1] = (LTable)NULL;
+	if (depth <= MAXDBDEPTH)
+	    EnterSearchCache(db, names, classes, depth,
+			     closure.list, closure.idx + 2);
 	_XUnlockMutex(&db->linfo);
     }
     closure.list[closure.idx + 1] = (LTable)NULL;
@@ -2679,6 +2796,7 @@ void XrmDestroyDatabase(db)
 	    else
 		DestroyNTable(table);
 	}
+	FlushSearchCache(db);
 	_XFreeMutex(&db->linfo);
 	(*db->methods->destroy)(db->mbstate);
 	Xfree((char *)db);
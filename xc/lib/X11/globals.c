@@ -78,6 +78,7 @@ from The Open Group.
 ZEROINIT (XErrorHandler, _XErrorFunction, NULL);
 ZEROINIT (XIOErrorHandler, _XIOErrorFunction, NULL);
 ZEROINIT (_XQEvent *, _qfree, NULL);
+ZEROINIT (PutImageShmType, _XPutImageShmFunc, NULL);
 
 
 /*
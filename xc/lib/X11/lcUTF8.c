@@ -379,6 +379,63 @@ init_all_charsets (void)
 	    init_all_charsets();					\
     } while (0)
 
+/*
+ * Converters to CharSet keep, between the XlcConvRec and the preferred
+ * charsets, a map of the ASCII characters that charset_wctocs would
+ * store as themselves in the first preferred charset.  Once that charset
+ * is the one being produced, such characters are copied straight
+ * through without a lookup.
+ */
+typedef struct _Utf8AsciiRec {
+    Utf8Conv charset;			/* first preferred charset */
+    unsigned char direct[0x80 / 8];	/* bit per ASCII character */
+} Utf8AsciiRec, *Utf8Ascii;
+
+#define AsciiMap(conv) ((Utf8Ascii) ((char *) (conv) + sizeof(XlcConvRec)))
+#define IsDirectAscii(map, c) ((map)->direct[(c) >> 3] & (1 << ((c) & 7)))
+
+static int charset_wctocs(
+    Utf8Conv *preferred,
+    Utf8Conv *charsetp,
+    XlcSide *sidep,
+    XlcConv conv,
+    unsigned char *r,
+    ucs4_t wc,
+    int n);
+
+static void
+init_ascii_map(
+    XlcConv conv,
+    Utf8Conv *preferred)
+{
+    Utf8Ascii map = AsciiMap(conv);
+    Utf8Conv chosen_charset;
+    XlcSide chosen_side;
+    unsigned char c[4];
+    int i;
+
+    map->charset = preferred[0];
+    memset(map->direct, 0, sizeof(map->direct));
+    if (map->charset == (Utf8Conv) NULL)
+	return;
+    for (i = 0; i < 0x80; i++)
+	if (charset_wctocs(preferred, &chosen_charset, &chosen_side,
+			   conv, c, (ucs4_t) i, sizeof(c)) == 1
+	    && chosen_charset == map->charset && c[0] == i)
+	    map->direct[i >> 3] |= 1 << (i & 7);
+}
+
+/* True if ASCII characters may bypass charset_wctocs after last_charset */
+static Bool
+ascii_direct(
+    Utf8Ascii map,
+    XlcCharSet last_charset)
+{
+    return (map->charset != (Utf8Conv) NULL
+	    && last_charset->xrm_encoding_name == map->charset->xrm_name
+	    && (last_charset->side == XlcGLGR || last_charset->side == XlcGL));
+}
+
 /* from XlcNCharSet to XlcNUtf8String */
 
 static int
@@ -497,11 +554,12 @@ create_tocs_conv(
     if (charset_num > all_charsets_count-1)
 	charset_num = all_charsets_count-1;
 
-    conv = (XlcConv) Xmalloc(sizeof(XlcConvRec)
+    conv = (XlcConv) Xmalloc(sizeof(XlcConvRec) + sizeof(Utf8AsciiRec)
 			     + (charset_num + 1) * sizeof(Utf8Conv));
     if (conv == (XlcConv) NULL)
 	return (XlcConv) NULL;
-    preferred = (Utf8Conv *) ((char *) conv + sizeof(XlcConvRec));
+    preferred = (Utf8Conv *) ((char *) conv + sizeof(XlcConvRec)
+			      + sizeof(Utf8AsciiRec));
 
     /* Loop through all codesets mentioned in the locale. */
     charset_num = 0;
@@ -526,6 +584,7 @@ create_tocs_conv(
 	}
     }
     preferred[charset_num] = (Utf8Conv) NULL;
+    init_ascii_map(conv, preferred);
 
     conv->methods = methods;
     conv->state = (XPointer) preferred;
@@ -596,6 +655,8 @@ utf8tocs(
     int num_args)
 {
     Utf8Conv *preferred_charsets;
+    Utf8Ascii ascii_map;
+    Bool direct = False;
     XlcCharSet last_charset = NULL;
     unsigned char const *src;
     unsigned char const *srcend;
@@ -607,6 +668,7 @@ utf8tocs(
 	return 0;
 
     preferred_charsets = (Utf8Conv *) conv->state;
+    ascii_map = AsciiMap(conv);
     src = (unsigned char const *) *from;
     srcend = src + *from_left;
     dst = (unsigned char *) *to;
@@ -620,6 +682,11 @@ utf8tocs(
 	int consumed;
 	int count;
 
+	if (direct && *src < 0x80 && IsDirectAscii(ascii_map, *src)) {
+	    *dst++ = *src++;
+	    continue;
+	}
+
 	consumed = utf8_mbtowc(NULL, &wc, src, srcend-src);
 	if (consumed == RET_TOOFEW(0))
 	    break;
@@ -646,6 +713,7 @@ utf8tocs(
 		unconv_num++;
 		continue;
 	    }
+	    direct = ascii_direct(ascii_map, last_charset);
 	} else {
 	    if (!(last_charset->xrm_encoding_name == chosen_charset->xrm_name
 	          && (last_charset->side == XlcGLGR
@@ -822,6 +890,12 @@ utf8tostr(
 	ucs4_t wc;
 	int consumed;
 
+	if (*src < 0x80) {
+	    if (dst == dstend)
+		break;
+	    *dst++ = *src++;
+	    continue;
+	}
 	consumed = utf8_mbtowc(NULL, &wc, src, srcend-src);
 	if (consumed == RET_TOOFEW(0))
 	    break;
@@ -891,11 +965,20 @@ strtoutf8(
     dst = (unsigned char *) *to;
     dstend = dst + *to_left;
 
+    /* Latin-1 takes one or two bytes of UTF-8 */
     while (src < srcend) {
-	int count = utf8_wctomb(NULL, dst, *src, dstend-dst);
-	if (count == RET_TOOSMALL)
-	    break;
-	dst += count;
+	unsigned char c = *src;
+
+	if (c < 0x80) {
+	    if (dst == dstend)
+		break;
+	    *dst++ = c;
+	} else {
+	    if (dstend - dst < 2)
+		break;
+	    *dst++ = 0xc0 | (c >> 6);
+	    *dst++ = 0x80 | (c & 0x3f);
+	}
 	src++;
     }
 
@@ -960,13 +1043,16 @@ create_ucstocs_conv(
 
 	lazy_init_all_charsets();
 
-	conv = (XlcConv) Xmalloc(sizeof(XlcConvRec) + 2 * sizeof(Utf8Conv));
+	conv = (XlcConv) Xmalloc(sizeof(XlcConvRec) + sizeof(Utf8AsciiRec)
+				 + 2 * sizeof(Utf8Conv));
 	if (conv == (XlcConv) NULL)
 	    return (XlcConv) NULL;
-	preferred = (Utf8Conv *) ((char *) conv + sizeof(XlcConvRec));
+	preferred = (Utf8Conv *) ((char *) conv + sizeof(XlcConvRec)
+				  + sizeof(Utf8AsciiRec));
 
 	preferred[0] = &all_charsets[0]; /* ISO10646 */
 	preferred[1] = (Utf8Conv) NULL;
+	init_ascii_map(conv, preferred);
 
 	conv->methods = methods;
 	conv->state = (XPointer) preferred;
@@ -1174,7 +1260,13 @@ utf8towcs(
 
     while (src < srcend && dst < dstend) {
 	ucs4_t wc;
-	int consumed = utf8_mbtowc(NULL, &wc, src, srcend-src);
+	int consumed;
+
+	if (*src < 0x80) {
+	    *dst++ = *src++;
+	    continue;
+	}
+	consumed = utf8_mbtowc(NULL, &wc, src, srcend-src);
 	if (consumed == RET_TOOFEW(0))
 	    break;
 	if (consumed == RET_ILSEQ) {
@@ -1240,7 +1332,15 @@ wcstoutf8(
     unconv_num = 0;
 
     while (src < srcend) {
-	int count = utf8_wctomb(NULL, dst, *src, dstend-dst);
+	int count;
+
+	if (*src >= 0 && *src < 0x80) {
+	    if (dst == dstend)
+		break;
+	    *dst++ = (unsigned char) *src++;
+	    continue;
+	}
+	count = utf8_wctomb(NULL, dst, *src, dstend-dst);
 	if (count == RET_TOOSMALL)
 	    break;
 	if (count == RET_ILSEQ) {
@@ -1487,6 +1587,8 @@ wcstocs(
     int num_args)
 {
     Utf8Conv *preferred_charsets;
+    Utf8Ascii ascii_map;
+    Bool direct = False;
     XlcCharSet last_charset = NULL;
     wchar_t const *src;
     wchar_t const *srcend;
@@ -1498,6 +1600,7 @@ wcstocs(
 	return 0;
 
     preferred_charsets = (Utf8Conv *) conv->state;
+    ascii_map = AsciiMap(conv);
     src = (wchar_t const *) *from;
     srcend = src + *from_left;
     dst = (unsigned char *) *to;
@@ -1510,6 +1613,12 @@ wcstocs(
 	wchar_t wc = *src;
 	int count;
 
+	if (direct && wc >= 0 && wc < 0x80 && IsDirectAscii(ascii_map, wc)) {
+	    *dst++ = (unsigned char) wc;
+	    src++;
+	    continue;
+	}
+
 	count = charset_wctocs(preferred_charsets, &chosen_charset, &chosen_side, conv, dst, wc, dstend-dst);
 	if (count == RET_TOOSMALL)
 	    break;
@@ -1527,6 +1636,7 @@ wcstocs(
 		unconv_num++;
 		continue;
 	    }
+	    direct = ascii_direct(ascii_map, last_charset);
 	} else {
 	    if (!(last_charset->xrm_encoding_name == chosen_charset->xrm_name
 	          && (last_charset->side == XlcGLGR
@@ -1741,10 +1851,12 @@ create_tofontcs_conv(
 	num += count;
     }
 
-    conv = (XlcConv) Xmalloc(sizeof(XlcConvRec) + (num + 1) * sizeof(Utf8Conv));
+    conv = (XlcConv) Xmalloc(sizeof(XlcConvRec) + sizeof(Utf8AsciiRec)
+			     + (num + 1) * sizeof(Utf8Conv));
     if (conv == (XlcConv) NULL)
 	return (XlcConv) NULL;
-    preferred = (Utf8Conv *) ((char *) conv + sizeof(XlcConvRec));
+    preferred = (Utf8Conv *) ((char *) conv + sizeof(XlcConvRec)
+			      + sizeof(Utf8AsciiRec));
 
     /* Loop through all fontsets mentioned in the locale. */
     for (i = 0, num = 0;; i++) {
@@ -1780,6 +1892,7 @@ create_tofontcs_conv(
         }
     }
     preferred[num] = (Utf8Conv) NULL;
+    init_ascii_map(conv, preferred);
 
     conv->methods = methods;
     conv->state = (XPointer) preferred;
@@ -37,6 +37,8 @@ in this Software without prior written authorization from The Open Group.
 #include <X11/extensions/shmstr.h>
 #include <X11/extensions/Xext.h>
 #include <X11/extensions/extutil.h>
+#include <sys/ipc.h>
+#include <sys/shm.h>
 
 static XExtensionInfo _shm_info_data;
 static XExtensionInfo *shm_info = &_shm_info_data;
@@ -82,7 +84,6 @@ static /* const */ char *shm_error_list[] = {
 static XEXT_GENERATE_FIND_DISPLAY (find_display, shm_info, shm_extension_name, 
 				   &shm_extension_hooks, ShmNumberEvents, NULL)
 
-static XEXT_GENERATE_CLOSE_DISPLAY (close_display, shm_info)
 
 static XEXT_GENERATE_ERROR_STRING (error_string, shm_extension_name,
 				   ShmNumberErrors, shm_error_list)
@@ -328,6 +329,189 @@ XImage *XShmCreateImage (dpy, visual, depth, format, data, shminfo,
     return image;
 }
 
+/*
+ * Shared images: XShmCreateSharedImage allocates the pixels in a
+ * segment attached to the server when the connection is local and the
+ * extension works, and in ordinary memory otherwise.  XPutImage on such
+ * an image sends a ShmPutImage followed by a round trip, so that, as
+ * with a plain XPutImage, the caller may change the pixels as soon as
+ * it returns.  Only the small request and a reply cross the socket.
+ */
+typedef struct _SharedImageRec {
+    XShmSegmentInfo shminfo;	/* first: image->obdata points here */
+    Display *dpy;		/* attached to, NULL once it is closed */
+    struct _SharedImageRec *next; /* the display's list, in info->data */
+} SharedImageRec;
+
+/*
+ * Images may be destroyed after their display is closed, so closing the
+ * display detaches their segments and forgets the display.
+ */
+static int close_display (Display *dpy, XExtCodes *codes)
+{
+    XExtDisplayInfo *info = find_display (dpy);
+    SharedImageRec *shared;
+
+    if (info) {
+	for (shared = (SharedImageRec *)info->data; shared;
+	     shared = shared->next) {
+	    if (XextHasExtension(info))
+		XShmDetach(dpy, &shared->shminfo);
+	    shared->dpy = NULL;
+	}
+	info->data = NULL;
+    }
+    return XextRemoveDisplay (shm_info, dpy);
+}
+
+static int _XShmDestroySharedImage (ximage)
+    XImage *ximage;
+{
+    SharedImageRec *shared = (SharedImageRec *)ximage->obdata;
+    SharedImageRec **prev;
+    XExtDisplayInfo *info;
+
+    if (shared) {
+	if (shared->dpy) {
+	    info = find_display (shared->dpy);
+	    for (prev = (SharedImageRec **)&info->data; *prev;
+		 prev = &(*prev)->next) {
+		if (*prev == shared) {
+		    *prev = shared->next;
+		    break;
+		}
+	    }
+	    XShmDetach(shared->dpy, &shared->shminfo);
+	}
+	shmdt(shared->shminfo.shmaddr);
+	Xfree((char *)shared);
+    } else if (ximage->data)
+	Xfree(ximage->data);
+    Xfree((char *)ximage);
+    return 1;
+}
+
+static Bool _XShmPutSharedImage (dpy, d, gc, image, src_x, src_y, dst_x, dst_y,
+				 width, height)
+    Display *dpy;
+    Drawable d;
+    GC gc;
+    XImage *image;
+    int src_x, src_y, dst_x, dst_y;
+    unsigned int width, height;
+{
+    SharedImageRec *shared = (SharedImageRec *)image->obdata;
+
+    if (image->f.destroy_image != _XShmDestroySharedImage ||
+	shared->dpy != dpy ||
+	image->byte_order != dpy->byte_order ||
+	image->bitmap_bit_order != dpy->bitmap_bit_order)
+	return False;
+    if (!XShmPutImage(dpy, d, gc, image, src_x, src_y, dst_x, dst_y,
+		      width, height, False))
+	return False;
+    XSync(dpy, False);
+    return True;
+}
+
+/* attach the segment and wait to see whether the server could */
+static Bool _XShmAttachChecked (dpy, info, shminfo)
+    Display *dpy;
+    XExtDisplayInfo *info;
+    XShmSegmentInfo *shminfo;
+{
+    register xShmAttachReq *req;
+    register xReq *sreq;
+    xGetInputFocusReply rep;
+    _XAsyncHandler async;
+    _XAsyncErrorState async_state;
+
+    shminfo->shmseg = XAllocID(dpy);
+    LockDisplay(dpy);
+    GetReq(ShmAttach, req);
+    req->reqType = info->codes->major_opcode;
+    req->shmReqType = X_ShmAttach;
+    req->shmseg = shminfo->shmseg;
+    req->shmid = shminfo->shmid;
+    req->readOnly = xFalse;
+    async_state.min_sequence_number = dpy->request;
+    async_state.max_sequence_number = dpy->request;
+    async_state.error_code = 0;
+    async_state.major_opcode = info->codes->major_opcode;
+    async_state.minor_opcode = X_ShmAttach;
+    async_state.error_count = 0;
+    async.next = dpy->async_handlers;
+    async.handler = _XAsyncErrorHandler;
+    async.data = (XPointer)&async_state;
+    dpy->async_handlers = &async;
+    GetEmptyReq(GetInputFocus, sreq);
+    (void) _XReply(dpy, (xReply *)&rep, 0, xTrue);
+    DeqAsyncHandler(dpy, &async);
+    UnlockDisplay(dpy);
+    SyncHandle();
+    return async_state.error_count == 0;
+}
+
+XImage *XShmCreateSharedImage (dpy, visual, depth, format, width, height)
+    register Display *dpy;
+    register Visual *visual;
+    unsigned int depth;
+    int format;
+    unsigned int width;
+    unsigned int height;
+{
+    XExtDisplayInfo *info = find_display (dpy);
+    register XImage *image;
+    SharedImageRec *shared;
+    char *name = DisplayString(dpy);
+    unsigned long size;
+
+    image = XShmCreateImage(dpy, visual, depth, format, (char *)NULL,
+			    (XShmSegmentInfo *)NULL, width, height);
+    if (!image)
+	return image;
+    image->f.destroy_image = _XShmDestroySharedImage;
+    size = image->bytes_per_line * height;
+    if (format != ZPixmap)
+	size *= depth;
+
+    /* a remote server could have a segment with the same id */
+    if (XextHasExtension(info) && name &&
+	(name[0] == ':' || !strncmp(name, "unix:", 5)) &&
+	(shared = (SharedImageRec *)Xcalloc(1, sizeof(SharedImageRec)))) {
+	shared->dpy = dpy;
+	shared->shminfo.shmid = shmget(IPC_PRIVATE, size, IPC_CREAT|0600);
+	if (shared->shminfo.shmid >= 0) {
+	    shared->shminfo.shmaddr = shmat(shared->shminfo.shmid, 0, 0);
+	    if (shared->shminfo.shmaddr != (char *)-1 &&
+		_XShmAttachChecked(dpy, info, &shared->shminfo)) {
+		/* gone once both sides have detached */
+		shmctl(shared->shminfo.shmid, IPC_RMID, 0);
+		shared->shminfo.readOnly = False;
+		image->data = shared->shminfo.shmaddr;
+		image->obdata = (char *)shared;
+		shared->next = (SharedImageRec *)info->data;
+		info->data = (XPointer)shared;
+		if (!_XPutImageShmFunc)
+		    _XPutImageShmFunc = _XShmPutSharedImage;
+		return image;
+	    }
+	    if (shared->shminfo.shmaddr != (char *)-1)
+		shmdt(shared->shminfo.shmaddr);
+	    shmctl(shared->shminfo.shmid, IPC_RMID, 0);
+	}
+	Xfree((char *)shared);
+    }
+
+    /* fall back to an ordinary image */
+    image->obdata = NULL;
+    if (!(image->data = Xmalloc(size))) {
+	Xfree((char *)image);
+	return NULL;
+    }
+    return image;
+}
+
 Status XShmPutImage (dpy, d, gc, image, src_x, src_y, dst_x, dst_y,
 		     src_width, src_height, send_event)
     register Display *dpy;
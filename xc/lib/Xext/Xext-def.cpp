@@ -21,6 +21,7 @@ EXPORTS
  XShmAttach
  XShmCreateImage
  XShmCreatePixmap
+ XShmCreateSharedImage
  XShmDetach
 ;XShmDestroyImage
  XShmGetEventBase
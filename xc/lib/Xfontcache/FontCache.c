@@ -212,3 +212,34 @@ Bool FontCacheGetCacheStatistics(dpy, cachestats)
     SyncHandle();
     return True;
 }
+
+Bool FontCacheGetNameCacheStatistics(dpy, namestats)
+    Display* dpy;
+    FontCacheNameStatistics *namestats;
+{
+    XExtDisplayInfo *info = find_display (dpy);
+    xFontCacheGetNameCacheStatisticsReply rep;
+    xFontCacheGetNameCacheStatisticsReq *req;
+
+    FontCacheCheckExtension (dpy, info, False);
+
+    LockDisplay(dpy);
+    GetReq(FontCacheGetNameCacheStatistics, req);
+    req->reqType = info->codes->major_opcode;
+    req->fontcacheReqType = X_FontCacheGetNameCacheStatistics;
+    if (!_XReply(dpy, (xReply *)&rep,
+		(SIZEOF(xFontCacheGetNameCacheStatisticsReply)-SIZEOF(xReply))>>2,
+		 xFalse)) {
+	UnlockDisplay(dpy);
+	SyncHandle();
+	return False;
+    }
+    namestats->open_hits = rep.open_hits;
+    namestats->open_misses = rep.open_misses;
+    namestats->list_hits = rep.list_hits;
+    namestats->list_misses = rep.list_misses;
+    namestats->flushes = rep.flushes;
+    UnlockDisplay(dpy);
+    SyncHandle();
+    return True;
+}
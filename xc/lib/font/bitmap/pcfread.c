@@ -73,6 +73,54 @@ pcfError (message, va_alist)
 static void pcfUnloadFont ( FontPtr pFont );
 static int  position;
 
+/*
+ * Glyph bitmaps which are stored in the file exactly as the server
+ * wants them are mapped rather than read, so that every server
+ * process using the font shares one copy through the page cache.
+ * Remember those mappings so they can be undone at unload time.
+ */
+typedef struct _PCFMapping {
+    struct _PCFMapping *next;
+    char	*bitmaps;
+    char	*base;
+    int		size;
+} PCFMappingRec, *PCFMappingPtr;
+
+static PCFMappingPtr pcfMappings;
+
+static char *
+pcfMapBitmaps(FontFilePtr file, int size)
+{
+    PCFMappingPtr   m;
+
+    m = (PCFMappingPtr) xalloc(sizeof(PCFMappingRec));
+    if (!m)
+	return NULL;
+    m->bitmaps = FontFileMapRead(file, size, &m->base, &m->size);
+    if (!m->bitmaps) {
+	xfree(m);
+	return NULL;
+    }
+    m->next = pcfMappings;
+    pcfMappings = m;
+    return m->bitmaps;
+}
+
+static void
+pcfFreeBitmaps(char *bitmaps)
+{
+    PCFMappingPtr   m, *prev;
+
+    for (prev = &pcfMappings; (m = *prev); prev = &m->next)
+	if (m->bitmaps == bitmaps) {
+	    *prev = m->next;
+	    FontFileUnmap(m->base, m->size);
+	    xfree(m);
+	    return;
+	}
+    xfree(bitmaps);
+}
+
 
 #define IS_EOF(file) ((file)->eof == BUFFILEEOF)
 
@@ -474,6 +522,17 @@ pcfReadFont(FontPtr pFont, FontFilePtr file,
     }
     
     sizebitmaps = bitmapSizes[PCF_GLYPH_PAD_INDEX(format)];
+    if (sizebitmaps && PCF_BIT_ORDER(format) == bit &&
+	PCF_GLYPH_PAD(format) == glyph &&
+	((PCF_BYTE_ORDER(format) == PCF_BIT_ORDER(format)) == (bit == byte) ||
+	 (bit == byte ? PCF_SCAN_UNIT(format) : scan) == 1))
+    {
+	bitmaps = pcfMapBitmaps(file, sizebitmaps);
+	if (bitmaps) {
+	    position += sizebitmaps;
+	    goto GotBitmaps;
+	}
+    }
     /* guard against completely empty font */
     bitmaps = xalloc(sizebitmaps ? sizebitmaps : 1);
     if (!bitmaps) {
@@ -524,6 +583,7 @@ pcfReadFont(FontPtr pFont, FontFilePtr file,
 	xfree(bitmaps);
 	bitmaps = padbitmaps;
     }
+GotBitmaps:
     for (i = 0; i < nbitmaps; i++)
 	metrics[i].bits = bitmaps + offsets[i];
 
@@ -658,7 +718,7 @@ Bail:
             xfree(encoding[i]);
     }
     xfree(encoding);
-    xfree(bitmaps);
+    pcfFreeBitmaps(bitmaps);
     xfree(metrics);
     xfree(pFont->info.props);
     pFont->info.nprops = 0;
@@ -756,7 +816,7 @@ pcfUnloadFont(FontPtr pFont)
             xfree(bitmapFont->encoding[i]);
     }
     xfree(bitmapFont->encoding);
-    xfree(bitmapFont->bitmaps);
+    pcfFreeBitmaps(bitmapFont->bitmaps);
     xfree(bitmapFont->metrics);
     xfree(pFont->info.isStringProp);
     xfree(pFont->info.props);
@@ -990,7 +1050,7 @@ Bail:
             xfree(encoding[i]);
     }
     xfree(encoding);
-    xfree(bitmaps);
+    pcfFreeBitmaps(bitmaps);
     xfree(metrics);
     xfree(pFont->info.props);
     pFont->info.nprops = 0;
@@ -38,6 +38,10 @@ from The Open Group.
 #include <fontmisc.h>
 #include <bufio.h>
 #include <errno.h>
+#ifdef HAS_MMAP
+#include <sys/types.h>
+#include <sys/mman.h>
+#endif
 
 BufFilePtr
 BufFileCreate (char *private,
@@ -207,3 +211,57 @@ BufFileFree (BufFilePtr f)
 {
     xfree (f);
 }
+
+/*
+ * Map the next count bytes of a plain file read-only instead of
+ * reading them, and step over them.  The pages are shared with every
+ * other process mapping the same file.  Returns NULL, leaving f as it
+ * was, when f is a filtered stream, the file is too short or the
+ * mapping fails.  *basep and *sizep describe the mapping for
+ * BufFileUnmap.
+ */
+char *
+BufFileMapRead (BufFilePtr f, int count, char **basep, int *sizep)
+{
+#ifdef HAS_MMAP
+    long    fileoff, end, pageoff;
+    int	    pagesize;
+    char    *base;
+
+    if (f->input != BufFileRawFill || count <= 0)
+	return NULL;
+    fileoff = lseek (FileDes(f), 0, SEEK_CUR);
+    if (fileoff == -1)
+	return NULL;
+    end = lseek (FileDes(f), 0, SEEK_END);
+    if (lseek (FileDes(f), fileoff, SEEK_SET) != fileoff)
+	return NULL;
+    /* bytes already buffered have not been consumed yet */
+    fileoff -= f->left;
+    if (end - fileoff < count)
+	return NULL;
+    pagesize = getpagesize ();
+    pageoff = fileoff & ~((long) pagesize - 1);
+    base = (char *) mmap (0, count + (fileoff - pageoff), PROT_READ,
+			  MAP_SHARED, FileDes(f), pageoff);
+    if (base == (char *) MAP_FAILED)
+	return NULL;
+    if (BufFileRawSkip (f, count) != count) {
+	munmap (base, count + (fileoff - pageoff));
+	return NULL;
+    }
+    *basep = base;
+    *sizep = count + (fileoff - pageoff);
+    return base + (fileoff - pageoff);
+#else
+    return NULL;
+#endif
+}
+
+void
+BufFileUnmap (char *base, int size)
+{
+#ifdef HAS_MMAP
+    munmap (base, size);
+#endif
+}
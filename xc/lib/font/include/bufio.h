@@ -76,6 +76,8 @@ extern int BufFileFlush ( BufFilePtr, int );
 extern int BufFileRead ( BufFilePtr, char*, int );
 extern int BufFileWrite ( BufFilePtr, char*, int );
 extern void BufFileFree ( BufFilePtr );
+extern char *BufFileMapRead ( BufFilePtr, int, char**, int* );
+extern void BufFileUnmap ( char*, int );
 
 #define BufFileGet(f)	((f)->left-- ? *(f)->bufp++ : ((f)->eof = (*(f)->input) (f)))
 #define BufFilePut(c,f)	(--(f)->left ? *(f)->bufp++ = ((unsigned char)(c)) : (*(f)->output) ((unsigned char)(c),f))
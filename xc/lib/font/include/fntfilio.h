@@ -44,6 +44,8 @@ typedef BufFilePtr  FontFilePtr;
 #define FontFileWrite(f,b,n)	BufFileWrite(f,b,n)
 #define FontFileSkip(f,n)   (BufFileSkip (f, n) != BUFFILEEOF)
 #define FontFileSeek(f,n)   (BufFileSeek (f,n,0) != BUFFILEEOF)
+#define FontFileMapRead(f,n,b,s)    BufFileMapRead(f,n,b,s)
+#define FontFileUnmap(b,s)  BufFileUnmap(b,s)
 
 #define FontFileEOF	BUFFILEEOF
 
@@ -751,6 +751,13 @@ TRANS(NoListen) (char * protocol)
    return 0;
 }
 
+void
+TRANS(SetListenBacklog) (int backlog)
+
+{
+    TRANS(ListenBacklog) = backlog;
+}
+
 int
 TRANS(ResetListener) (XtransConnInfo ciptr)
 
@@ -339,6 +339,10 @@ int TRANS(ResetListener)(
     XtransConnInfo	/* ciptr */
 );
 
+void TRANS(SetListenBacklog)(
+    int			/* backlog */
+);
+
 XtransConnInfo TRANS(Accept)(
     XtransConnInfo,	/* ciptr */
     int *		/* status */
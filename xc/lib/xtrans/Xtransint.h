@@ -421,6 +421,9 @@ static int trans_mkdir (
     char *,		/* path */
     int			/* mode */
 );
+
+/* listen() backlog for new listeners, 0 for the transport's default */
+static int TRANS(ListenBacklog);
 #endif
 
 /*
@@ -165,6 +165,8 @@ static int IBMsockInit = 0;
 #ifndef BACKLOG
 #define BACKLOG MIN_BACKLOG
 #endif
+#define LISTEN_BACKLOG \
+    (TRANS(ListenBacklog) > 0 ? TRANS(ListenBacklog) : BACKLOG)
 /*
  * This is the Socket implementation of the X Transport service layer
  *
@@ -788,7 +790,7 @@ TRANS(SocketCreateListener) (XtransConnInfo ciptr,
 #endif
 }
 
-    if (listen (fd, BACKLOG) < 0)
+    if (listen (fd, LISTEN_BACKLOG) < 0)
     {
 	PRMSG (1, "SocketCreateListener: listen() failed\n", 0, 0, 0);
 	close (fd);
@@ -1051,7 +1053,7 @@ TRANS(SocketUNIXResetListener) (XtransConnInfo ciptr)
 	    return TRANS_RESET_FAILURE;
 	}
 
-	if (listen (ciptr->fd, BACKLOG) < 0)
+	if (listen (ciptr->fd, LISTEN_BACKLOG) < 0)
 	{
 	    close (ciptr->fd);
 	    TRANS(FreeConnInfo) (ciptr);
@@ -41,6 +41,7 @@
 #include "scrnintstr.h"
 #include "inputstr.h"
 #include "servermd.h"
+#include "dixfont.h"
 #define _FONTCACHE_SERVER_
 #include "fontcacheP.h"
 #include "fontcachstr.h"
@@ -59,11 +60,13 @@ static void FontCacheResetProc(
 static DISPATCH_PROC(ProcFontCacheDispatch);
 static DISPATCH_PROC(ProcFontCacheGetCacheSettings);
 static DISPATCH_PROC(ProcFontCacheGetCacheStatistics);
+static DISPATCH_PROC(ProcFontCacheGetNameCacheStatistics);
 static DISPATCH_PROC(ProcFontCacheQueryVersion);
 static DISPATCH_PROC(ProcFontCacheChangeCacheSettings);
 static DISPATCH_PROC(SProcFontCacheDispatch);
 static DISPATCH_PROC(SProcFontCacheGetCacheSettings);
 static DISPATCH_PROC(SProcFontCacheGetCacheStatistics);
+static DISPATCH_PROC(SProcFontCacheGetNameCacheStatistics);
 static DISPATCH_PROC(SProcFontCacheQueryVersion);
 static DISPATCH_PROC(SProcFontCacheChangeCacheSettings);
 
@@ -209,6 +212,40 @@ ProcFontCacheGetCacheStatistics(client)
     return (client->noClientException);
 }
 
+static int
+ProcFontCacheGetNameCacheStatistics(client)
+    register ClientPtr client;
+{
+    xFontCacheGetNameCacheStatisticsReply rep;
+    unsigned long openHits, openMisses, listHits, listMisses, flushes;
+    register int n;
+
+    REQUEST_SIZE_MATCH(xFontCacheGetNameCacheStatisticsReq);
+    rep.type = X_Reply;
+    rep.sequenceNumber = client->sequence;
+    rep.length = 0;
+
+    GetFontNameCacheStatistics(&openHits, &openMisses,
+			       &listHits, &listMisses, &flushes);
+    rep.open_hits = openHits;
+    rep.open_misses = openMisses;
+    rep.list_hits = listHits;
+    rep.list_misses = listMisses;
+    rep.flushes = flushes;
+    rep.reserve0 = 0;
+    if (client->swapped) {
+    	swaps(&rep.sequenceNumber, n);
+	swapl(&rep.open_hits, n);
+	swapl(&rep.open_misses, n);
+	swapl(&rep.list_hits, n);
+	swapl(&rep.list_misses, n);
+	swapl(&rep.flushes, n);
+    }
+    WriteToClient(client, SIZEOF(xFontCacheGetNameCacheStatisticsReply),
+		  (char *)&rep);
+    return (client->noClientException);
+}
+
 static int
 ProcFontCacheChangeCacheSettings(client)
     register ClientPtr client;
@@ -251,6 +288,8 @@ ProcFontCacheDispatch (client)
 	return ProcFontCacheGetCacheSettings(client);
     case X_FontCacheGetCacheStatistics:
 	return ProcFontCacheGetCacheStatistics(client);
+    case X_FontCacheGetNameCacheStatistics:
+	return ProcFontCacheGetNameCacheStatistics(client);
     case X_FontCacheChangeCacheSettings:
 	return ProcFontCacheChangeCacheSettings(client);
     default:
@@ -290,6 +329,17 @@ SProcFontCacheGetCacheStatistics(client)
     return ProcFontCacheGetCacheStatistics(client);
 }
 
+static int
+SProcFontCacheGetNameCacheStatistics(client)
+    ClientPtr client;
+{
+    register int n;
+    REQUEST(xFontCacheGetNameCacheStatisticsReq);
+    swaps(&stuff->length, n);
+    REQUEST_SIZE_MATCH(xFontCacheGetNameCacheStatisticsReq);
+    return ProcFontCacheGetNameCacheStatistics(client);
+}
+
 static int
 SProcFontCacheChangeCacheSettings(client)
     ClientPtr client;
@@ -319,6 +369,8 @@ SProcFontCacheDispatch (client)
 	return SProcFontCacheGetCacheSettings(client);
     case X_FontCacheGetCacheStatistics:
 	return SProcFontCacheGetCacheStatistics(client);
+    case X_FontCacheGetNameCacheStatistics:
+	return SProcFontCacheGetNameCacheStatistics(client);
     case X_FontCacheChangeCacheSettings:
 	return SProcFontCacheChangeCacheSettings(client);
     default:
@@ -43,6 +43,7 @@ in this Software without prior written authorization from The Open Group.
 #include "shapestr.h"
 #include "regionstr.h"
 #include "gcstruct.h"
+#include "servermd.h"
 #ifdef EXTMODULE
 #include "xf86_ansic.h"
 #endif
@@ -155,6 +156,132 @@ typedef struct _ShapeEvent {
     XID		    clientResource;
 } ShapeEventRec;
 
+/*
+ * Clients tend to install the same mask bitmap over and over: shaped
+ * clocks and eyes reshape on every tick, and window managers decorate
+ * many frames with identical rounded corners.  Converting a bitmap to a
+ * region scans every bit, so the regions of the most recently used masks
+ * are kept, keyed by their contents, and copied out on a match.
+ */
+
+#define SHAPE_MASK_CACHE_SIZE	8
+#define SHAPE_MASK_CACHE_BYTES	(64 * 1024)	/* largest bitmap cached */
+
+typedef struct _ShapeMaskCache {
+    ScreenPtr	    pScreen;
+    int		    width, height;
+    unsigned long   hash;
+    int		    nbytes;
+    char	    *bits;
+    RegionPtr	    pRegion;
+    unsigned long   lastUsed;
+} ShapeMaskCacheRec, *ShapeMaskCachePtr;
+
+static ShapeMaskCacheRec    ShapeMaskCache[SHAPE_MASK_CACHE_SIZE];
+static unsigned long	    ShapeMaskClock;
+
+static void
+ShapeFlushMaskCache ()
+{
+    ShapeMaskCachePtr	pEnt;
+    int			i;
+
+    for (i = 0, pEnt = ShapeMaskCache; i < SHAPE_MASK_CACHE_SIZE; i++, pEnt++)
+    {
+	if (pEnt->pRegion)
+	    REGION_DESTROY(pEnt->pScreen, pEnt->pRegion);
+	if (pEnt->bits)
+	    xfree (pEnt->bits);
+	pEnt->pScreen = NULL;
+	pEnt->pRegion = NULL;
+	pEnt->bits = NULL;
+    }
+    ShapeMaskClock = 0;
+}
+
+static RegionPtr
+ShapeMaskToRegion (pScreen, pPixmap)
+    ScreenPtr	pScreen;
+    PixmapPtr	pPixmap;
+{
+    ShapeMaskCachePtr	pEnt, pVictim;
+    RegionPtr		pRegion;
+    int			width = pPixmap->drawable.width;
+    int			height = pPixmap->drawable.height;
+    int			nbytes, i;
+    unsigned long	hash;
+    unsigned char	*bits, *b;
+
+    nbytes = PixmapBytePad(width, 1) * height;
+    if (nbytes > SHAPE_MASK_CACHE_BYTES ||
+	!(bits = (unsigned char *) xalloc (nbytes)))
+	return BITMAP_TO_REGION(pScreen, pPixmap);
+    /* pad bits are left alone by GetImage; make them compare equal */
+    bzero ((char *) bits, nbytes);
+    (*pScreen->GetImage) ((DrawablePtr) pPixmap, 0, 0, width, height,
+			  ZPixmap, ~0L, (char *) bits);
+    hash = 0;
+    for (i = nbytes, b = bits; i--; b++)
+	hash = (hash << 5) + (hash >> 27) + *b;
+
+    pVictim = ShapeMaskCache;
+    for (i = 0, pEnt = ShapeMaskCache; i < SHAPE_MASK_CACHE_SIZE; i++, pEnt++)
+    {
+	if (pEnt->pRegion && pEnt->pScreen == pScreen &&
+	    pEnt->hash == hash && pEnt->width == width &&
+	    pEnt->height == height &&
+	    !memcmp (pEnt->bits, (char *) bits, nbytes))
+	{
+	    xfree (bits);
+	    pEnt->lastUsed = ++ShapeMaskClock;
+	    pRegion = REGION_CREATE(pScreen, NullBox, 1);
+	    if (pRegion && !REGION_COPY(pScreen, pRegion, pEnt->pRegion))
+	    {
+		REGION_DESTROY(pScreen, pRegion);
+		pRegion = NullRegion;
+	    }
+	    return pRegion;
+	}
+	if (!pEnt->pRegion ||
+	    (pVictim->pRegion && pEnt->lastUsed < pVictim->lastUsed))
+	    pVictim = pEnt;
+    }
+
+    pRegion = BITMAP_TO_REGION(pScreen, pPixmap);
+    if (!pRegion)
+    {
+	xfree (bits);
+	return NullRegion;
+    }
+    if (pVictim->pRegion)
+    {
+	REGION_DESTROY(pVictim->pScreen, pVictim->pRegion);
+	xfree (pVictim->bits);
+	pVictim->pRegion = NullRegion;
+	pVictim->bits = NULL;
+    }
+    pVictim->pRegion = REGION_CREATE(pScreen, NullBox, 1);
+    if (pVictim->pRegion &&
+	!REGION_COPY(pScreen, pVictim->pRegion, pRegion))
+    {
+	REGION_DESTROY(pScreen, pVictim->pRegion);
+	pVictim->pRegion = NullRegion;
+    }
+    if (pVictim->pRegion)
+    {
+	pVictim->pScreen = pScreen;
+	pVictim->width = width;
+	pVictim->height = height;
+	pVictim->hash = hash;
+	pVictim->nbytes = nbytes;
+	pVictim->bits = (char *) bits;
+	pVictim->lastUsed = ++ShapeMaskClock;
+    }
+    else
+	xfree (bits);
+    return pRegion;
+}
+
 /****************
  * ShapeExtensionInit
  *
@@ -186,6 +313,7 @@ static void
 ShapeResetProc (extEntry)
 ExtensionEntry	*extEntry;
 {
+    ShapeFlushMaskCache ();
 }
 
 static int
@@ -460,7 +588,7 @@ ProcShapeMask (client)
 	if (pPixmap->drawable.pScreen != pScreen ||
 	    pPixmap->drawable.depth != 1)
 	    return BadMatch;
-	srcRgn = BITMAP_TO_REGION(pScreen, pPixmap);
+	srcRgn = ShapeMaskToRegion (pScreen, pPixmap);
 	if (!srcRgn)
 	    return BadAlloc;
     }
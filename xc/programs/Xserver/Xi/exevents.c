@@ -836,6 +836,8 @@ RecalculateDeviceDeliverableEvents(pWin)
 	{
 	if ((inputMasks = wOtherInputMasks(pChild)) != 0)
 	    {
+	    for (i=0; i<EMASKSIZE; i++)
+		inputMasks->inputEvents[i] = 0;
 	    for (others = inputMasks->inputClients; others; 
 		others = others->next)
 		{
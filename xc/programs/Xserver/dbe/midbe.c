@@ -296,6 +296,11 @@ miDbeAliasBuffers(pDbeWindowPriv)
  *
  *     This is the MI function for the DbeSwapBuffers request.
  *
+ *     All windows in the swap list that are on the same screen and of the
+ *     same depth as the first one are swapped in one call, sharing a single
+ *     scratch GC.  Each swap is a CopyArea from the back buffer; windows
+ *     have no storage of their own that could be exchanged with it.
+ *
  *****************************************************************************/
 
 static int
@@ -304,127 +309,137 @@ miDbeSwapBuffers(client, pNumWindows, swapInfo)
     int			*pNumWindows;
     DbeSwapInfoPtr	swapInfo;
 {
+    ScreenPtr			pScreen;
     DbeScreenPrivPtr		pDbeScreenPriv;
     GCPtr		    	pGC;
     WindowPtr		    	pWin;
     MiDbeWindowPrivPrivPtr	pDbeWindowPrivPriv; 
     PixmapPtr			pTmpBuffer;
     xRectangle			clearRect;
+    int				swapAction;
+    int				i, nLeft;
 
 
-    pWin               = swapInfo[0].pWindow;
-    pDbeScreenPriv     = DBE_SCREEN_PRIV_FROM_WINDOW(pWin);
-    pDbeWindowPrivPriv = MI_DBE_WINDOW_PRIV_PRIV_FROM_WINDOW(pWin);
-    pGC = GetScratchGC(pWin->drawable.depth, pWin->drawable.pScreen);
-
-    /*
-     **********************************************************************
-     ** Setup before swap.
-     **********************************************************************
-     */
+    pScreen        = swapInfo[0].pWindow->drawable.pScreen;
+    pDbeScreenPriv = DBE_SCREEN_PRIV(pScreen);
+    pGC            = GetScratchGC(swapInfo[0].pWindow->drawable.depth, pScreen);
+    if (!pGC)
+    {
+        return(BadAlloc);
+    }
 
-    switch(swapInfo[0].swapAction)
+    for (i = 0, nLeft = 0; i < *pNumWindows; i++)
     {
-        case XdbeUndefined:
-            break;
+        pWin       = swapInfo[i].pWindow;
+        swapAction = swapInfo[i].swapAction;
+
+        if (pWin->drawable.pScreen != pScreen ||
+            pWin->drawable.depth != pGC->depth)
+        {
+            /* Leave windows on other screens or of other depths for the
+             * next call, so that nothing can fail once swapping started.
+             */
+            swapInfo[nLeft++] = swapInfo[i];
+            continue;
+        }
+
+        pDbeWindowPrivPriv = MI_DBE_WINDOW_PRIV_PRIV_FROM_WINDOW(pWin);
+
+        /*
+         ******************************************************************
+         ** Setup before swap.
+         ******************************************************************
+         */
+
+        switch(swapAction)
+        {
+            case XdbeUndefined:
+                break;
 
-        case XdbeBackground:
-            break;
+            case XdbeBackground:
+                break;
 
-        case XdbeUntouched:
-            ValidateGC((DrawablePtr)pDbeWindowPrivPriv->pFrontBuffer, pGC);
-            (*pGC->ops->CopyArea)((DrawablePtr)pWin,
+            case XdbeUntouched:
+                ValidateGC((DrawablePtr)pDbeWindowPrivPriv->pFrontBuffer, pGC);
+                (*pGC->ops->CopyArea)((DrawablePtr)pWin,
                                   (DrawablePtr)pDbeWindowPrivPriv->pFrontBuffer,
                                   pGC, 0, 0, pWin->drawable.width,
                                   pWin->drawable.height, 0, 0);
-            break;
+                break;
 
-        case XdbeCopied:
-            break;
+            case XdbeCopied:
+                break;
 
-    }
+        }
 
-    /*
-     **********************************************************************
-     ** Swap.
-     **********************************************************************
-     */
+        /*
+         ******************************************************************
+         ** Swap.
+         ******************************************************************
+         */
 
-    ValidateGC((DrawablePtr)pWin, pGC);
-    (*pGC->ops->CopyArea)((DrawablePtr)pDbeWindowPrivPriv->pBackBuffer,
-                          (DrawablePtr)pWin, pGC, 0, 0,
-                          pWin->drawable.width, pWin->drawable.height,
-                          0, 0);
+        ValidateGC((DrawablePtr)pWin, pGC);
+        (*pGC->ops->CopyArea)((DrawablePtr)pDbeWindowPrivPriv->pBackBuffer,
+                              (DrawablePtr)pWin, pGC, 0, 0,
+                              pWin->drawable.width, pWin->drawable.height,
+                              0, 0);
 
-    /*
-     **********************************************************************
-     ** Tasks after swap.
-     **********************************************************************
-     */
+        /*
+         ******************************************************************
+         ** Tasks after swap.
+         ******************************************************************
+         */
 
-    switch(swapInfo[0].swapAction)
-    {
-        case XdbeUndefined:
-            break;
-
-        case XdbeBackground:
-            if ((*pDbeScreenPriv->SetupBackgroundPainter)(pWin, pGC))
-            {
-                ValidateGC((DrawablePtr)pDbeWindowPrivPriv->pBackBuffer, pGC);
-                clearRect.x = 0;
-                clearRect.y = 0;
-                clearRect.width =
-                    pDbeWindowPrivPriv->pBackBuffer->drawable.width;
-                clearRect.height =
-                    pDbeWindowPrivPriv->pBackBuffer->drawable.height;
-                (*pGC->ops->PolyFillRect)(
+        switch(swapAction)
+        {
+            case XdbeUndefined:
+                break;
+
+            case XdbeBackground:
+                if ((*pDbeScreenPriv->SetupBackgroundPainter)(pWin, pGC))
+                {
+                    ValidateGC((DrawablePtr)pDbeWindowPrivPriv->pBackBuffer,
+                               pGC);
+                    clearRect.x = 0;
+                    clearRect.y = 0;
+                    clearRect.width =
+                        pDbeWindowPrivPriv->pBackBuffer->drawable.width;
+                    clearRect.height =
+                        pDbeWindowPrivPriv->pBackBuffer->drawable.height;
+                    (*pGC->ops->PolyFillRect)(
 				(DrawablePtr)pDbeWindowPrivPriv->pBackBuffer,
 				pGC, 1, &clearRect);
-	    }
-            break;
+	        }
+                break;
 
-        case XdbeUntouched:
-            /* Swap pixmap pointers. */
-            pTmpBuffer = pDbeWindowPrivPriv->pBackBuffer;
-            pDbeWindowPrivPriv->pBackBuffer =
-                pDbeWindowPrivPriv->pFrontBuffer;
-            pDbeWindowPrivPriv->pFrontBuffer = pTmpBuffer;
+            case XdbeUntouched:
+                /* Swap pixmap pointers. */
+                pTmpBuffer = pDbeWindowPrivPriv->pBackBuffer;
+                pDbeWindowPrivPriv->pBackBuffer =
+                    pDbeWindowPrivPriv->pFrontBuffer;
+                pDbeWindowPrivPriv->pFrontBuffer = pTmpBuffer;
 
-            miDbeAliasBuffers(pDbeWindowPrivPriv->pDbeWindowPriv);
+                miDbeAliasBuffers(pDbeWindowPrivPriv->pDbeWindowPriv);
 
-            break;
+                break;
 
-        case XdbeCopied:
-            break;
+            case XdbeCopied:
+                break;
 
-    }
+        }
 
-    /* Remove the swapped window from the swap information array and decrement
-     * pNumWindows to indicate to the DIX level how many windows were actually
-     * swapped.
-     */
+    } /* for (i = 0; i < *pNumWindows; i++) */
 
-    if (*pNumWindows > 1)
-    {
-        /* We were told to swap more than one window, but we only swapped the
-         * first one.  Remove the first window in the list by moving the last
-         * window to the beginning.
-         */
-        swapInfo[0].pWindow    = swapInfo[*pNumWindows - 1].pWindow;
-        swapInfo[0].swapAction = swapInfo[*pNumWindows - 1].swapAction;
-
-        /* Clear the last window information just to be safe. */
-        swapInfo[*pNumWindows - 1].pWindow    = (WindowPtr)NULL;
-        swapInfo[*pNumWindows - 1].swapAction = 0;
-    }
-    else
+    /* Clear the information of the windows we swapped just to be safe, and
+     * tell the DIX level how many windows are left for other screens.
+     */
+    for (i = nLeft; i < *pNumWindows; i++)
     {
-        /* Clear the window information just to be safe. */
-        swapInfo[0].pWindow    = (WindowPtr)NULL;
-        swapInfo[0].swapAction = 0;
+        swapInfo[i].pWindow    = (WindowPtr)NULL;
+        swapInfo[i].swapAction = 0;
     }
 
-    (*pNumWindows)--;
+    *pNumWindows = nLeft;
 
     FreeScratchGC(pGC);
 
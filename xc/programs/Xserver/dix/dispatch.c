@@ -3563,6 +3563,45 @@ InitProcVectors(void)
     
 }
 
+extern int clientPrivateLen;
+extern unsigned *clientPrivateSizes;
+extern unsigned totalClientSize;
+
+/*
+ * Records of clients which have gone are kept for reuse by new
+ * connections, as long as the size of a client record (which includes
+ * the privates) has not changed since.
+ */
+#define CLIENT_POOL_SIZE    32
+
+static ClientPtr clientPool[CLIENT_POOL_SIZE];
+static int clientPoolCount;
+static unsigned clientPoolRecSize;
+
+static ClientPtr
+AllocClientRec()
+{
+    if (clientPoolCount && clientPoolRecSize == totalClientSize)
+	return clientPool[--clientPoolCount];
+    return (ClientPtr)xalloc(totalClientSize);
+}
+
+static void
+FreeClientRec(client)
+    ClientPtr client;
+{
+    if (clientPoolRecSize != totalClientSize)
+    {
+	while (clientPoolCount)
+	    xfree(clientPool[--clientPoolCount]);
+	clientPoolRecSize = totalClientSize;
+    }
+    if (clientPoolCount < CLIENT_POOL_SIZE)
+	clientPool[clientPoolCount++] = client;
+    else
+	xfree(client);
+}
+
 /**********************
  * CloseDownClient
  *
@@ -3655,7 +3694,7 @@ CloseDownClient(client)
 #ifdef SMART_SCHEDULE
 	SmartLastClient = NullClient;
 #endif
-	xfree(client);
+	FreeClientRec(client);
 
 	while (!clients[currentMaxClients-1])
 	    currentMaxClients--;
@@ -3759,10 +3798,6 @@ void InitClient(client, i, ospriv)
 #endif
 }
 
-extern int clientPrivateLen;
-extern unsigned *clientPrivateSizes;
-extern unsigned totalClientSize;
-
 int
 InitClientPrivates(client)
     ClientPtr client;
@@ -3817,14 +3852,14 @@ NextAvailableClient(ospriv)
     i = nextFreeClientID;
     if (i == MAXCLIENTS)
 	return (ClientPtr)NULL;
-    clients[i] = client = (ClientPtr)xalloc(totalClientSize);
+    clients[i] = client = AllocClientRec();
     if (!client)
 	return (ClientPtr)NULL;
     InitClient(client, i, ospriv);
     InitClientPrivates(client);
     if (!InitClientResources(client))
     {
-	xfree(client);
+	FreeClientRec(client);
 	return (ClientPtr)NULL;
     }
     data.reqType = 1;
@@ -3832,7 +3867,7 @@ NextAvailableClient(ospriv)
     if (!InsertFakeRequest(client, (char *)&data, sz_xReq))
     {
 	FreeClientResources(client);
-	xfree(client);
+	FreeClientRec(client);
 	return (ClientPtr)NULL;
     }
     if (i == currentMaxClients)
@@ -71,6 +71,205 @@ static int  size_slept_fpes = 0;
 static FontPathElementPtr *slept_fpes = (FontPathElementPtr *) 0;
 static FontPatternCachePtr patternCache;
 
+/*
+ * Font name resolution cache.  Opening a font by a name which is not
+ * already loaded walks every FPE in the path, following aliases, and
+ * ListFonts walks them all again; both answers only change when the
+ * font path does.  Remember, for a requested name, the final name
+ * and the FPE that opened it, and for a ListFonts pattern, the reply
+ * data.  Only requests which completed without sleeping (i.e. without
+ * a font server in the loop) are entered.  Everything is discarded
+ * when the font path is set, which is also when the fontfile FPEs
+ * notice changed directories.
+ */
+#define FONT_NAME_CACHE_SIZE	256
+#define FONT_LIST_CACHE_SIZE	32
+
+typedef struct _FontNameCacheEntry {
+    char	*name;
+    int		namelen;
+    char	*resolved;
+    int		resolvedlen;
+    int		fpe;
+} FontNameCacheEntryRec, *FontNameCacheEntryPtr;
+
+typedef struct _FontListCacheEntry {
+    char	*pattern;
+    int		patlen;
+    unsigned int max_names;
+    int		nnames;
+    char	*data;
+    int		datalen;
+} FontListCacheEntryRec, *FontListCacheEntryPtr;
+
+static FontNameCacheEntryRec fontNameCache[FONT_NAME_CACHE_SIZE];
+static FontListCacheEntryRec fontListCache[FONT_LIST_CACHE_SIZE];
+static unsigned long fontOpenHits, fontOpenMisses;
+static unsigned long fontListHits, fontListMisses;
+static unsigned long fontNameCacheFlushes;
+
+static unsigned int
+#if NeedFunctionPrototypes
+FontNameHash(char *name, int len)
+#else
+FontNameHash(name, len)
+    char	*name;
+    int		len;
+#endif
+{
+    unsigned int h = 0;
+
+    while (len--)
+	h = (h << 5) + h + (unsigned char) *name++;
+    return h;
+}
+
+static void
+#if NeedFunctionPrototypes
+FreeFontNameCacheEntry(FontNameCacheEntryPtr e)
+#else
+FreeFontNameCacheEntry(e)
+    FontNameCacheEntryPtr e;
+#endif
+{
+    xfree(e->name);
+    e->name = NULL;
+    e->resolved = NULL;
+}
+
+static void
+#if NeedFunctionPrototypes
+FlushFontNameCache(void)
+#else
+FlushFontNameCache()
+#endif
+{
+    int i;
+
+    for (i = 0; i < FONT_NAME_CACHE_SIZE; i++)
+	FreeFontNameCacheEntry(&fontNameCache[i]);
+    for (i = 0; i < FONT_LIST_CACHE_SIZE; i++) {
+	xfree(fontListCache[i].pattern);
+	fontListCache[i].pattern = NULL;
+	fontListCache[i].data = NULL;
+    }
+    fontNameCacheFlushes++;
+}
+
+static FontNameCacheEntryPtr
+#if NeedFunctionPrototypes
+FindFontNameCache(char *name, int len)
+#else
+FindFontNameCache(name, len)
+    char	*name;
+    int		len;
+#endif
+{
+    FontNameCacheEntryPtr e;
+
+    e = &fontNameCache[FontNameHash(name, len) % FONT_NAME_CACHE_SIZE];
+    if (e->name && e->namelen == len && !memcmp(e->name, name, len))
+	return e;
+    return NULL;
+}
+
+static void
+#if NeedFunctionPrototypes
+CacheFontName(char *name, int len, char *resolved, int resolvedlen, int fpe)
+#else
+CacheFontName(name, len, resolved, resolvedlen, fpe)
+    char	*name;
+    int		len;
+    char	*resolved;
+    int		resolvedlen;
+    int		fpe;
+#endif
+{
+    FontNameCacheEntryPtr e;
+    char	*mem;
+
+    /* name and resolved name share one allocation */
+    mem = (char *) xalloc(len + resolvedlen);
+    if (!mem)
+	return;
+    e = &fontNameCache[FontNameHash(name, len) % FONT_NAME_CACHE_SIZE];
+    FreeFontNameCacheEntry(e);
+    memmove(mem, name, len);
+    memmove(mem + len, resolved, resolvedlen);
+    e->name = mem;
+    e->namelen = len;
+    e->resolved = mem + len;
+    e->resolvedlen = resolvedlen;
+    e->fpe = fpe;
+}
+
+static FontListCacheEntryPtr
+#if NeedFunctionPrototypes
+FindFontListCache(char *pattern, int len, unsigned int max_names)
+#else
+FindFontListCache(pattern, len, max_names)
+    char	*pattern;
+    int		len;
+    unsigned int max_names;
+#endif
+{
+    FontListCacheEntryPtr e;
+
+    e = &fontListCache[FontNameHash(pattern, len) % FONT_LIST_CACHE_SIZE];
+    if (e->pattern && e->patlen == len && e->max_names == max_names &&
+	!memcmp(e->pattern, pattern, len))
+	return e;
+    return NULL;
+}
+
+static void
+#if NeedFunctionPrototypes
+CacheFontList(char *pattern, int len, unsigned int max_names,
+	      int nnames, char *data, int datalen)
+#else
+CacheFontList(pattern, len, max_names, nnames, data, datalen)
+    char	*pattern;
+    int		len;
+    unsigned int max_names;
+    int		nnames;
+    char	*data;
+    int		datalen;
+#endif
+{
+    FontListCacheEntryPtr e;
+    char	*mem;
+
+    mem = (char *) xalloc(len + datalen);
+    if (!mem)
+	return;
+    e = &fontListCache[FontNameHash(pattern, len) % FONT_LIST_CACHE_SIZE];
+    xfree(e->pattern);
+    memmove(mem, pattern, len);
+    memmove(mem + len, data, datalen);
+    e->pattern = mem;
+    e->patlen = len;
+    e->max_names = max_names;
+    e->nnames = nnames;
+    e->data = mem + len;
+    e->datalen = datalen;
+}
+
+void
+GetFontNameCacheStatistics(openHits, openMisses, listHits, listMisses,
+			   flushes)
+    unsigned long *openHits;
+    unsigned long *openMisses;
+    unsigned long *listHits;
+    unsigned long *listMisses;
+    unsigned long *flushes;
+{
+    *openHits = fontOpenHits;
+    *openMisses = fontOpenMisses;
+    *listHits = fontListHits;
+    *listMisses = fontListMisses;
+    *flushes = fontNameCacheFlushes;
+}
+
 int
 FontToXError(err)
     int         err;
@@ -278,6 +477,7 @@ doOpenFont(client, c)
 	err = Successful;
 	goto bail;
     }
+retry:
     while (c->current_fpe < c->num_fpes) {
 	fpe = c->fpe_list[c->current_fpe];
 	err = (*fpe_functions[fpe->type].open_font)
@@ -309,6 +509,8 @@ doOpenFont(client, c)
 	    continue;
 	}
 	if (err == BadFontName) {
+	    if (c->fromCache)
+		break;
 	    c->current_fpe++;
 	    continue;
 	}
@@ -322,12 +524,35 @@ doOpenFont(client, c)
 	break;
     }
 
+    /*
+     * A name cache entry which no longer leads anywhere; forget it
+     * and search the whole path for the name as requested.
+     */
+    if (c->fromCache && (err == BadFontName || (err == Successful && !pfont)))
+    {
+	FontNameCacheEntryPtr e = FindFontNameCache(c->reqname, c->reqnamelen);
+
+	if (e)
+	    FreeFontNameCacheEntry(e);
+	xfree(c->fontname);
+	c->fontname = c->reqname;
+	c->fnamelen = c->reqnamelen;
+	c->reqname = NULL;
+	c->fromCache = FALSE;
+	c->current_fpe = 0;
+	aliascount = 20;
+	err = Successful;
+	goto retry;
+    }
     if (err != Successful)
 	goto bail;
     if (!pfont) {
 	err = BadFontName;
 	goto bail;
     }
+    if (!c->slept && !c->fromCache)
+	CacheFontName(c->origFontName, c->origFontNameLen,
+		      c->fontname, c->fnamelen, c->current_fpe);
     if (!pfont->fpe)
 	pfont->fpe = fpe;
     pfont->refcnt++;
@@ -365,6 +590,7 @@ bail:
     }
     xfree(c->fpe_list);
     xfree(c->fontname);
+    xfree(c->reqname);
     xfree(c);
     return TRUE;
 }
@@ -380,6 +606,7 @@ OpenFont(client, fid, flags, lenfname, pfontname)
     OFclosurePtr c;
     int         i;
     FontPtr     cached = (FontPtr)0;
+    FontNameCacheEntryPtr e;
 
 #ifdef FONTDEBUG
     char *f;
@@ -423,10 +650,32 @@ OpenFont(client, fid, flags, lenfname, pfontname)
     c = (OFclosurePtr) xalloc(sizeof(OFclosureRec));
     if (!c)
 	return BadAlloc;
-    c->fontname = (char *) xalloc(lenfname);
     c->origFontName = pfontname;
     c->origFontNameLen = lenfname;
+    c->reqname = NULL;
+    c->reqnamelen = lenfname;
+    c->fromCache = FALSE;
+    /*
+     * Start from the name and FPE this name resolved to last time; keep
+     * the requested name in case that no longer works.
+     */
+    e = FindFontNameCache(pfontname, lenfname);
+    if (e && e->fpe < num_fpes) {
+	c->reqname = (char *) xalloc(lenfname);
+	if (!c->reqname) {
+	    xfree(c);
+	    return BadAlloc;
+	}
+	memmove(c->reqname, pfontname, lenfname);
+	pfontname = e->resolved;
+	lenfname = e->resolvedlen;
+	c->fromCache = TRUE;
+	fontOpenHits++;
+    } else
+	fontOpenMisses++;
+    c->fontname = (char *) xalloc(lenfname);
     if (!c->fontname) {
+	xfree(c->reqname);
 	xfree(c);
 	return BadAlloc;
     }
@@ -438,6 +687,7 @@ OpenFont(client, fid, flags, lenfname, pfontname)
 	xalloc(sizeof(FontPathElementPtr) * num_fpes);
     if (!c->fpe_list) {
 	xfree(c->fontname);
+	xfree(c->reqname);
 	xfree(c);
 	return BadAlloc;
     }
@@ -448,7 +698,7 @@ OpenFont(client, fid, flags, lenfname, pfontname)
     }
     c->client = client;
     c->fontid = fid;
-    c->current_fpe = 0;
+    c->current_fpe = c->fromCache ? e->fpe : 0;
     c->num_fpes = num_fpes;
     c->fnamelen = lenfname;
     c->slept = FALSE;
@@ -822,6 +1072,10 @@ finish:
     client->pSwapReplyFunc = ReplySwapVector[X_ListFonts];
     WriteSwappedDataToClient(client, sizeof(xListFontsReply), &reply);
     (void) WriteToClient(client, stringLens + nnames, bufferStart);
+    if (!c->slept && !c->haveSaved)
+	CacheFontList(c->current.pattern, c->current.patlen,
+		      c->current.max_names, nnames,
+		      bufferStart, stringLens + nnames);
     DEALLOCATE_LOCAL(bufferStart);
 
 bail:
@@ -846,6 +1100,7 @@ ListFonts(client, pattern, length, max_names)
 {
     int         i;
     LFclosurePtr c;
+    FontListCacheEntryPtr e;
 
     /* 
      * The right error to return here would be BadName, however the
@@ -856,6 +1111,21 @@ ListFonts(client, pattern, length, max_names)
     if (length > XLFDMAXFONTNAMELEN)
 	return BadAlloc;
 
+    if ((e = FindFontListCache((char *) pattern, length, max_names))) {
+	xListFontsReply reply;
+
+	fontListHits++;
+	reply.type = X_Reply;
+	reply.length = (e->datalen + 3) >> 2;
+	reply.nFonts = e->nnames;
+	reply.sequenceNumber = client->sequence;
+	client->pSwapReplyFunc = ReplySwapVector[X_ListFonts];
+	WriteSwappedDataToClient(client, sizeof(xListFontsReply), &reply);
+	(void) WriteToClient(client, e->datalen, e->data);
+	return Success;
+    }
+    fontListMisses++;
+
     if (!(c = (LFclosurePtr) xalloc(sizeof *c)))
 	return BadAlloc;
     c->fpe_list = (FontPathElementPtr *)
@@ -1826,6 +2096,7 @@ SetFontPathElements(npaths, paths, bad, persist)
     font_path_elements = fplist;
     if (patternCache)
 	EmptyFontPatternCache(patternCache);
+    FlushFontNameCache();
     num_fpes = valid_paths;
 
     return Success;
@@ -2086,6 +2357,7 @@ FreeFonts()
 	FreeFontPatternCache(patternCache);
 	patternCache = 0;
     }
+    FlushFontNameCache();
     FreeFontPath(font_path_elements, num_fpes, TRUE);
     font_path_elements = 0;
     num_fpes = 0;
@@ -1660,9 +1660,17 @@ DeliverEventsToWindow(pWin, pEvents, count, filter, grab, mskidx)
 	    other = inputMasks->inputClients;
 	}
 	else
-	    other = (InputClients *)wOtherClients(pWin);
+	{
+	    /* otherEventMasks summarizes the list; skip it when it can't match */
+	    if (!(wOtherEventMasks(pWin) & filter))
+		other = (InputClients *)NULL;
+	    else
+		other = (InputClients *)wOtherClients(pWin);
+	}
 	for (; other; other = other->next)
 	{
+	    if (!(other->mask[mskidx] & filter))
+		continue;
 	    if ( (attempt = TryClientEvents(rClient(other), pEvents, count,
 					  other->mask[mskidx], filter, grab)) )
 	    {
@@ -1874,7 +1882,13 @@ DeliverDeviceEvents(pWin, xE, grab, stopAt, dev, count)
 	    child = pWin->drawable.id;
 	    pWin = pWin->parent;
 	    if (pWin)
+	    {
 		inputMasks = wOtherInputMasks(pWin);
+		/* nothing from here up selects it */
+		if (inputMasks &&
+		    !(filter & inputMasks->deliverableEvents[mskidx]))
+		    return 0;
+	    }
 	}
     }
     else
@@ -1897,6 +1911,9 @@ DeliverDeviceEvents(pWin, xE, grab, stopAt, dev, count)
 		return 0;
 	    child = pWin->drawable.id;
 	    pWin = pWin->parent;
+	    /* deliverableEvents includes what propagates from above */
+	    if (pWin && !(filter & pWin->deliverableEvents))
+		return 0;
 	}
     }
     return 0;
@@ -1969,21 +1986,16 @@ PointInBorderSize(WindowPtr pWin, int x, int y)
     return FALSE;
 }
 
-static WindowPtr 
+static Bool
 #if NeedFunctionPrototypes
-XYToWindow(int x, int y)
+PointInWindow(WindowPtr pWin, int x, int y)
 #else
-XYToWindow(x, y)
-	int x, y;
+PointInWindow(pWin, x, y)
+    WindowPtr pWin;
+    int x, y;
 #endif
 {
-    register WindowPtr  pWin;
-
-    spriteTraceGood = 1;	/* root window still there */
-    pWin = ROOT->firstChild;
-    while (pWin)
-    {
-	if ((pWin->mapped) &&
+    return ((pWin->mapped) &&
 		(x >= pWin->drawable.x - wBorderWidth (pWin)) &&
 		(x < pWin->drawable.x + (int)pWin->drawable.width +
 		    wBorderWidth(pWin)) &&
@@ -2004,21 +2016,294 @@ XYToWindow(x, y)
 		 */
 		&& !pWin->rootlessUnhittable
 #endif
-		)
+		);
+}
+
+/*
+ * Picking index.  Walking the children of a window with thousands of
+ * mapped children on every motion event is expensive, so once a walk
+ * has to pass over PICK_INDEX_MIN siblings, the mapped children of that
+ * parent are bucketed into a uniform grid over their bounding boxes.
+ * Each cell lists, in stacking order, the children overlapping it;
+ * children spanning more than PICK_INDEX_MAX_CELLS cells are kept on a
+ * separate list instead of being entered everywhere.  An index is
+ * rebuilt on first use after windowTreeSerial changes.
+ */
+
+#define PICK_INDEX_SLOTS	4
+#define PICK_INDEX_MIN		32
+#define PICK_INDEX_MAX_GRID	64
+#define PICK_INDEX_MAX_CELLS	16
+
+typedef struct _PickIndex {
+    WindowPtr	    pParent;
+    unsigned long   serial;
+    unsigned long   lastUsed;
+    int		    nwin;
+    WindowPtr	    *wins;	/* mapped children, top to bottom */
+    int		    nbig;
+    int		    *big;	/* indices into wins of large children */
+    int		    x1, y1, x2, y2; /* extents; may exceed a BoxRec's range */
+    int		    gw, gh;	/* grid dimensions in cells */
+    int		    cw, ch;	/* cell size in pixels */
+    int		    *start;	/* gw * gh + 1 offsets into entries */
+    int		    *entries;	/* indices into wins */
+} PickIndexRec, *PickIndexPtr;
+
+static PickIndexRec pickIndex[PICK_INDEX_SLOTS];
+static unsigned long pickIndexClock;
+
+static void
+#if NeedFunctionPrototypes
+FreePickIndex(PickIndexPtr pIdx)
+#else
+FreePickIndex(pIdx)
+    PickIndexPtr pIdx;
+#endif
+{
+    xfree(pIdx->wins);
+    xfree(pIdx->big);
+    xfree(pIdx->start);
+    xfree(pIdx->entries);
+    bzero((char *)pIdx, sizeof(PickIndexRec));
+}
+
+/* cell holding pixel offset off, clamped to the grid */
+#define PickCell(off, size, cells) \
+    ((off) <= 0 ? 0 : (off) / (size) >= (cells) ? (cells) - 1 : (off) / (size))
+
+static Bool
+#if NeedFunctionPrototypes
+BuildPickIndex(PickIndexPtr pSlot, WindowPtr pParent)
+#else
+BuildPickIndex(pSlot, pParent)
+    PickIndexPtr pSlot;
+    WindowPtr pParent;
+#endif
+{
+    register WindowPtr pWin;
+    PickIndexRec idx;
+    PickIndexPtr pIdx;
+    int x1, y1, x2, y2;
+    int n, i, j, cx, cy, cx1, cy1, cx2, cy2, nentries, ncells;
+    int width, height;
+
+    n = 0;
+    for (pWin = pParent->firstChild; pWin; pWin = pWin->nextSib)
+	if (pWin->mapped)
+	    n++;
+    if (n < PICK_INDEX_MIN)
+	return FALSE;
+
+    /* build aside so that a failure leaves the slot as it was */
+    bzero((char *)&idx, sizeof(PickIndexRec));
+    pIdx = &idx;
+    pIdx->wins = (WindowPtr *)xalloc(n * sizeof(WindowPtr));
+    pIdx->big = (int *)xalloc(n * sizeof(int));
+    if (!pIdx->wins || !pIdx->big)
+    {
+	FreePickIndex(pIdx);
+	return FALSE;
+    }
+    for (i = 0, pWin = pParent->firstChild; pWin; pWin = pWin->nextSib)
+    {
+	if (!pWin->mapped)
+	    continue;
+	x1 = pWin->drawable.x - wBorderWidth (pWin);
+	y1 = pWin->drawable.y - wBorderWidth (pWin);
+	x2 = pWin->drawable.x + (int)pWin->drawable.width +
+	     wBorderWidth (pWin);
+	y2 = pWin->drawable.y + (int)pWin->drawable.height +
+	     wBorderWidth (pWin);
+	if (i == 0 || x1 < pIdx->x1) pIdx->x1 = x1;
+	if (i == 0 || y1 < pIdx->y1) pIdx->y1 = y1;
+	if (i == 0 || x2 > pIdx->x2) pIdx->x2 = x2;
+	if (i == 0 || y2 > pIdx->y2) pIdx->y2 = y2;
+	pIdx->wins[i++] = pWin;
+    }
+    pIdx->nwin = n;
+    width = pIdx->x2 - pIdx->x1;
+    height = pIdx->y2 - pIdx->y1;
+    if (width <= 0 || height <= 0)
+    {
+	FreePickIndex(pIdx);
+	return FALSE;
+    }
+    for (pIdx->gw = 1; pIdx->gw * pIdx->gw < n &&
+			pIdx->gw < PICK_INDEX_MAX_GRID; pIdx->gw++)
+	;
+    pIdx->gh = pIdx->gw;
+    pIdx->cw = (width + pIdx->gw - 1) / pIdx->gw;
+    pIdx->ch = (height + pIdx->gh - 1) / pIdx->gh;
+    ncells = pIdx->gw * pIdx->gh;
+    pIdx->start = (int *)xcalloc(ncells + 1, sizeof(int));
+    if (!pIdx->start)
+    {
+	FreePickIndex(pIdx);
+	return FALSE;
+    }
+
+    /* count, then fill; both passes walk the children top to bottom */
+    for (j = 0; j < 2; j++)
+    {
+	pIdx->nbig = 0;
+	for (i = 0; i < n; i++)
 	{
-	    if (spriteTraceGood >= spriteTraceSize)
+	    pWin = pIdx->wins[i];
+	    cx1 = PickCell(pWin->drawable.x - wBorderWidth (pWin) -
+			   pIdx->x1, pIdx->cw, pIdx->gw);
+	    cy1 = PickCell(pWin->drawable.y - wBorderWidth (pWin) -
+			   pIdx->y1, pIdx->ch, pIdx->gh);
+	    cx2 = PickCell(pWin->drawable.x + (int)pWin->drawable.width +
+			   wBorderWidth (pWin) - 1 - pIdx->x1, pIdx->cw, pIdx->gw);
+	    cy2 = PickCell(pWin->drawable.y + (int)pWin->drawable.height +
+			   wBorderWidth (pWin) - 1 - pIdx->y1, pIdx->ch, pIdx->gh);
+	    if ((cx2 - cx1 + 1) * (cy2 - cy1 + 1) > PICK_INDEX_MAX_CELLS)
 	    {
-		spriteTraceSize += 10;
-		Must_have_memory = TRUE; /* XXX */
-		spriteTrace = (WindowPtr *)xrealloc(
-		    spriteTrace, spriteTraceSize*sizeof(WindowPtr));
-		Must_have_memory = FALSE; /* XXX */
+		pIdx->big[pIdx->nbig++] = i;
+		continue;
 	    }
-	    spriteTrace[spriteTraceGood++] = pWin;
-	    pWin = pWin->firstChild;
+	    for (cy = cy1; cy <= cy2; cy++)
+		for (cx = cx1; cx <= cx2; cx++)
+		{
+		    if (j == 0)
+			pIdx->start[cy * pIdx->gw + cx + 1]++;
+		    else
+			pIdx->entries[pIdx->start[cy * pIdx->gw + cx]++] = i;
+		}
 	}
-	else
-	    pWin = pWin->nextSib;
+	if (j == 0)
+	{
+	    for (i = 1; i <= ncells; i++)
+		pIdx->start[i] += pIdx->start[i - 1];
+	    nentries = pIdx->start[ncells];
+	    pIdx->entries = (int *)xalloc((nentries ? nentries : 1) *
+					  sizeof(int));
+	    if (!pIdx->entries)
+	    {
+		FreePickIndex(pIdx);
+		return FALSE;
+	    }
+	}
+    }
+    /* the fill pass left each start at the following cell's start */
+    for (i = ncells; i > 0; i--)
+	pIdx->start[i] = pIdx->start[i - 1];
+    pIdx->start[0] = 0;
+
+    pIdx->pParent = pParent;
+    pIdx->serial = windowTreeSerial;
+    FreePickIndex(pSlot);
+    *pSlot = idx;
+    return TRUE;
+}
+
+static WindowPtr
+#if NeedFunctionPrototypes
+LookupPickIndex(PickIndexPtr pIdx, int x, int y)
+#else
+LookupPickIndex(pIdx, x, y)
+    PickIndexPtr pIdx;
+    int x, y;
+#endif
+{
+    int best = pIdx->nwin;
+    int i, cell;
+
+    if (x >= pIdx->x1 && x < pIdx->x2 && y >= pIdx->y1 && y < pIdx->y2)
+    {
+	cell = PickCell(y - pIdx->y1, pIdx->ch, pIdx->gh) * pIdx->gw +
+	       PickCell(x - pIdx->x1, pIdx->cw, pIdx->gw);
+	for (i = pIdx->start[cell]; i < pIdx->start[cell + 1]; i++)
+	    if (PointInWindow(pIdx->wins[pIdx->entries[i]], x, y))
+	    {
+		best = pIdx->entries[i];
+		break;
+	    }
+	/* a large child stacked above the cell's hit may cover it */
+	for (i = 0; i < pIdx->nbig && pIdx->big[i] < best; i++)
+	    if (PointInWindow(pIdx->wins[pIdx->big[i]], x, y))
+	    {
+		best = pIdx->big[i];
+		break;
+	    }
+    }
+    return (best < pIdx->nwin) ? pIdx->wins[best] : NullWindow;
+}
+
+/*
+ * Returns the topmost mapped child of pParent containing (x, y)
+ */
+static WindowPtr
+#if NeedFunctionPrototypes
+PickChildWindow(WindowPtr pParent, int x, int y)
+#else
+PickChildWindow(pParent, x, y)
+    WindowPtr pParent;
+    int x, y;
+#endif
+{
+    register WindowPtr pWin;
+    PickIndexPtr pIdx, pVictim;
+    int i, n;
+
+    pVictim = pickIndex;
+    for (i = 0, pIdx = pickIndex; i < PICK_INDEX_SLOTS; i++, pIdx++)
+    {
+	if (pIdx->pParent == pParent)
+	{
+	    if (pIdx->serial == windowTreeSerial ||
+		BuildPickIndex(pIdx, pParent))
+	    {
+		pIdx->lastUsed = ++pickIndexClock;
+		return LookupPickIndex(pIdx, x, y);
+	    }
+	    FreePickIndex(pIdx);
+	    pVictim = NULL;
+	    break;
+	}
+	if (pVictim && pIdx->lastUsed < pVictim->lastUsed)
+	    pVictim = pIdx;
+    }
+
+    /* BuildPickIndex only takes mapped children, so only count those */
+    n = 0;
+    for (pWin = pParent->firstChild; pWin; pWin = pWin->nextSib)
+    {
+	if (PointInWindow(pWin, x, y))
+	    break;
+	if (pWin->mapped)
+	    n++;
+    }
+    if (n >= PICK_INDEX_MIN && pVictim &&
+	BuildPickIndex(pVictim, pParent))
+	pVictim->lastUsed = ++pickIndexClock;
+    return pWin;
+}
+
+static WindowPtr 
+#if NeedFunctionPrototypes
+XYToWindow(int x, int y)
+#else
+XYToWindow(x, y)
+	int x, y;
+#endif
+{
+    register WindowPtr  pWin;
+
+    spriteTraceGood = 1;	/* root window still there */
+    pWin = ROOT;
+    while ((pWin = PickChildWindow(pWin, x, y)))
+    {
+	if (spriteTraceGood >= spriteTraceSize)
+	{
+	    spriteTraceSize += 10;
+	    Must_have_memory = TRUE; /* XXX */
+	    spriteTrace = (WindowPtr *)xrealloc(
+		spriteTrace, spriteTraceSize*sizeof(WindowPtr));
+	    Must_have_memory = FALSE; /* XXX */
+	}
+	spriteTrace[spriteTraceGood++] = pWin;
     }
     return spriteTrace[spriteTraceGood-1];
 }
@@ -4095,6 +4380,10 @@ InitEvents()
 void
 CloseDownEvents(void)
 {
+  int i;
+
+  for (i = 0; i < PICK_INDEX_SLOTS; i++)
+    FreePickIndex(&pickIndex[i]);
   xfree(spriteTrace);
   spriteTrace = NULL;
   spriteTraceSize = 0;
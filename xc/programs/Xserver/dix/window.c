@@ -131,6 +131,14 @@ extern void WindowHasNewCursor();
 extern void RecalculateDeliverableEvents();
 #endif
 
+#ifdef XINPUT
+extern void RecalculateDeviceDeliverableEvents(
+#if NeedFunctionPrototypes
+    WindowPtr /* pWin */
+#endif
+);
+#endif
+
 static Bool TileScreenSaver(
 #if NeedFunctionPrototypes
     int /*i*/,
@@ -163,6 +171,14 @@ static Bool TileScreenSaver(
 int numSaveUndersViewable = 0;
 int deltaSaveUndersViewable = 0;
 
+/*
+ * Bumped whenever a mapped window may have changed position, size,
+ * stacking or mapped state, or a window is freed; anything caching
+ * the window tree layout (the pointer picking index in events.c)
+ * compares against this
+ */
+unsigned long windowTreeSerial = 0;
+
 #ifdef DEBUG
 /******
  * PrintWindowTree
@@ -256,6 +272,8 @@ int	defaultBackingStore = NotUseful;
 /* hack to force no backing store */
 Bool	disableBackingStore = FALSE;
 Bool	enableBackingStore = FALSE;
+/* kilobytes of backing store pixmaps allowed, 0 for no limit */
+unsigned long backingStoreLimit = 0;
 /* hack to force no save unders */
 Bool	disableSaveUnders = FALSE;
 
@@ -870,6 +888,7 @@ CrushTree(pWin)
 
     if (!(pChild = pWin->firstChild))
 	return;
+    windowTreeSerial++;
     UnrealizeWindow = pWin->drawable.pScreen->UnrealizeWindow;
     while (1)
     {
@@ -953,6 +972,7 @@ DeleteWindow(value, wid)
 	    pWin->prevSib->nextSib = pWin->nextSib;
     }
     xfree(pWin);
+    windowTreeSerial++;
     return Success;
 }
 
@@ -1636,6 +1656,7 @@ MoveWindowInStack(pWin, pNextSib)
 		     pFirstChange = pFirstChange->nextSib;
 	    }
 	}
+	windowTreeSerial++;
 	if(pWin->drawable.pScreen->RestackWindow)
 	    (*pWin->drawable.pScreen->RestackWindow)(pWin, pOldNextSib);
     }
@@ -1799,6 +1820,8 @@ ResizeChildrenWinSize(pWin, dx, dy, dw, dh)
     register WindowPtr pSib, pChild;
     Bool resized = (dw || dh);
 
+    windowTreeSerial++;
+
     pScreen = pWin->drawable.pScreen;
 
     for (pSib = pWin->firstChild; pSib; pSib = pSib->nextSib)
@@ -2514,6 +2537,7 @@ ActuallyDoSomething:
 	}
 	else
 	    pWin->borderWidth = bw;
+	windowTreeSerial++;
     }
     if (action == MOVE_WIN)
 	(*pWin->drawable.pScreen->MoveWindow)(pWin, x, y, pSib,
@@ -2700,6 +2724,7 @@ ReparentWindow(pWin, pParent, x, y, client)
     pWin->origin.y = y + bw;
     pWin->drawable.x = x + bw + pParent->drawable.x;
     pWin->drawable.y = y + bw + pParent->drawable.y;
+    windowTreeSerial++;
 
     /* clip to parent */
     SetWinSize (pWin);
@@ -2715,6 +2740,9 @@ ReparentWindow(pWin, pParent, x, y, client)
     if (WasMapped)
 	MapWindow(pWin, client);
     RecalculateDeliverableEvents(pWin);
+#ifdef XINPUT
+    RecalculateDeviceDeliverableEvents(pWin);
+#endif
     return(Success);
 }
 
@@ -2828,6 +2856,7 @@ MapWindow(pWin, client)
 	}
 
 	pWin->mapped = TRUE;
+	windowTreeSerial++;
 	if (SubStrSend(pWin, pParent))
 	{
 	    event.u.u.type = MapNotify;
@@ -2868,6 +2897,7 @@ MapWindow(pWin, client)
 	RegionRec   temp;
 
 	pWin->mapped = TRUE;
+	windowTreeSerial++;
 	pWin->realized = TRUE;	   /* for roots */
 	pWin->viewable = pWin->drawable.class == InputOutput;
 	/* We SHOULD check for an error value here XXX */
@@ -2932,6 +2962,7 @@ MapSubwindows(pParent, client)
 	    }
     
 	    pWin->mapped = TRUE;
+	    windowTreeSerial++;
 	    if (parentNotify || StrSend(pWin))
 	    {
 		event.u.u.type = MapNotify;
@@ -3107,6 +3138,7 @@ UnmapWindow(pWin, fromConfigure)
 	(*pScreen->MarkWindow)(pLayerWin->parent);
     }
     pWin->mapped = FALSE;
+    windowTreeSerial++;
     if (wasRealized)
 	UnrealizeTree(pWin, fromConfigure);
     if (wasViewable)
@@ -3178,6 +3210,7 @@ UnmapSubwindows(pWin)
 		anyMarked = TRUE;
 	    }
 	    pChild->mapped = FALSE;
+	    windowTreeSerial++;
 	    if (pChild->realized)
 		UnrealizeTree(pChild, FALSE);
 	    if (wasViewable)
@@ -3254,7 +3287,10 @@ HandleSaveSet(client)
 			       pWin->drawable.y - wBorderWidth (pWin) - pParent->drawable.y,
 			       client);
 		if(!pWin->realized && pWin->mapped)
+		{
 		    pWin->mapped = FALSE;
+		    windowTreeSerial++;
+		}
 	    }
 	    MapWindow(pWin, client);
 	}
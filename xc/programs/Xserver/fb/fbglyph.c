@@ -248,6 +248,90 @@ fbGlyph24 (FbBits   *dstBits,
 #endif
 #endif
 
+/*
+ * Runs of glyphs from terminal emulator fonts, where every glyph fills
+ * the same cell, are packed side by side into one stipple which is then
+ * expanded in a single pass, so each destination word is stored once per
+ * scanline rather than once per glyph.  The run is checked against the
+ * clip as a whole; runs which are not entirely visible are left to the
+ * glyph at a time code.
+ */
+#define FB_GLYPH_RUN_STIPS  1024
+
+static Bool
+fbGlyphRun (DrawablePtr	    pDrawable,
+	    GCPtr	    pGC,
+	    int		    x,
+	    int		    y,
+	    unsigned int    nglyph,
+	    CharInfoPtr	    *ppci,
+	    pointer	    pglyphBase,
+	    Bool	    opaque)
+{
+    FbGCPrivPtr	    pPriv = fbGetGCPrivate (pGC);
+    FontPtr	    pFont = pGC->font;
+    FbStip	    stips[FB_GLYPH_RUN_STIPS];
+    FbStip	    *glyphBits, *dst;
+    FbStip	    bits, mask;
+    FbStride	    gStride, stride;
+    CharInfoPtr	    pci;
+    int		    gWidth, gHeight;
+    int		    width, shift;
+    int		    n, max, i, b, h;
+
+    if (!TERMINALFONT (pFont) || !nglyph)
+	return FALSE;
+    gWidth = FONTMAXBOUNDS (pFont, characterWidth);
+    gHeight = FONTASCENT (pFont) + FONTDESCENT (pFont);
+    if (gWidth <= 0 || gWidth > FB_STIP_UNIT || gHeight <= 0)
+	return FALSE;
+    y -= FONTASCENT (pFont);
+    if (!fbGlyphIn (fbGetCompositeClip (pGC), x, y,
+		    nglyph * gWidth, gHeight))
+	return FALSE;
+    /* glyphs per pass such that the packed stipple fits in stips */
+    max = ((FB_GLYPH_RUN_STIPS / gHeight) << FB_STIP_SHIFT) / gWidth;
+    if (!max)
+	return FALSE;
+    mask = FbStipMask (0, gWidth);
+    while (nglyph)
+    {
+	n = nglyph < max ? nglyph : max;
+	width = n * gWidth;
+	stride = (width + FB_STIP_MASK) >> FB_STIP_SHIFT;
+	memset (stips, 0, stride * gHeight * sizeof (FbStip));
+	for (i = 0, b = 0; i < n; i++, b += gWidth)
+	{
+	    pci = *ppci++;
+	    glyphBits = (FbStip *) FONTGLYPHBITS (pglyphBase, pci);
+	    gStride = GLYPHWIDTHBYTESPADDED (pci) / sizeof (FbStip);
+	    dst = stips + (b >> FB_STIP_SHIFT);
+	    shift = b & FB_STIP_MASK;
+	    for (h = gHeight; h--; glyphBits += gStride, dst += stride)
+	    {
+		bits = *glyphBits & mask;
+		dst[0] |= FbStipRight (bits, shift);
+		if (shift + gWidth > FB_STIP_UNIT)
+		    dst[1] |= FbStipLeft (bits, FB_STIP_UNIT - shift);
+	    }
+	}
+	fbPutXYImage (pDrawable,
+		      fbGetCompositeClip (pGC),
+		      pPriv->fg,
+		      pPriv->bg,
+		      pPriv->pm,
+		      opaque ? GXcopy : pGC->alu,
+		      opaque,
+
+		      x, y, width, gHeight,
+
+		      stips, stride, 0);
+	x += width;
+	nglyph -= n;
+    }
+    return TRUE;
+}
+
 void
 fbPolyGlyphBlt (DrawablePtr	pDrawable,
 		GCPtr		pGC,
@@ -293,6 +377,10 @@ fbPolyGlyphBlt (DrawablePtr	pDrawable,
     x += pDrawable->x;
     y += pDrawable->y;
 
+    if (pGC->fillStyle == FillSolid &&
+	fbGlyphRun (pDrawable, pGC, x, y, nglyph, ppci, pglyphBase, FALSE))
+	return;
+
     while (nglyph--)
     {
 	pci = *ppci++;
@@ -385,6 +473,9 @@ fbImageGlyphBlt (DrawablePtr	pDrawable,
     x += pDrawable->x;
     y += pDrawable->y;
 
+    if (fbGlyphRun (pDrawable, pGC, x, y, nglyph, ppciInit, pglyphBase, TRUE))
+	return;
+
     if (TERMINALFONT (pGC->font)
 #ifndef FBNOPIXADDR
 	&& !glyph
@@ -123,11 +123,32 @@ if (((rx1) < (rx2)) && ((ry1) < (ry2)) &&			\
     r++;							\
 }
 
+/*
+ * Compare two scanlines of a bitmap, ignoring the pad bits
+ */
+static Bool
+fbBitmapLineSame (FbBits *a, FbBits *b, int width)
+{
+    int	    n = width >> FB_SHIFT;
+
+    if (n && memcmp (a, b, n * sizeof (FbBits)))
+	return FALSE;
+    if (width & FB_MASK)
+    {
+	FbBits	mask = FbBitsMask (0, width & FB_MASK);
+
+	if ((a[n] ^ b[n]) & mask)
+	    return FALSE;
+    }
+    return TRUE;
+}
+
 /* Convert bitmap clip mask into clipping region. 
  * First, goes through each line and makes boxes by noting the transitions
  * from 0 to 1 and 1 to 0.
  * Then it coalesces the current line with the previous if they have boxes
- * at the same X coordinates.
+ * at the same X coordinates.  A line whose bits match the previous one
+ * is coalesced without being scanned.
  */
 RegionPtr
 fbPixmapToRegion(PixmapPtr pPix)
@@ -160,6 +181,13 @@ fbPixmapToRegion(PixmapPtr pPix)
     irectPrevStart = -1;
     for(h = 0; h < pPix->drawable.height; h++)
     {
+	if (h && fbBitmapLineSame (pwLine - nWidth, pwLine, width))
+	{
+	    for (prectO = FirstRect + irectPrevStart; prectO < rects; prectO++)
+		prectO->y2 += 1;
+	    pwLine += nWidth;
+	    continue;
+	}
 	pw = pwLine;
 	pwLine += nWidth;
 	irectLineStart = rects - FirstRect;
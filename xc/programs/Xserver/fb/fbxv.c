@@ -0,0 +1,773 @@
+/*
+   Copyright (c) 2003  XFree86 Inc
+*/
+/* $XFree86$ */
+
+/*
+ * Software XVideo for fb.  YUV images are converted to the pixel format
+ * of the destination visual and scaled in horizontal bands; each band is
+ * handed to the GC PutImage op, so clipping and the framebuffer layout
+ * are the business of the existing image code.
+ *
+ * The conversion entry points are usable without the adaptor: a DDX
+ * with direct framebuffer access can call fbXvConvertBand to write
+ * straight into video memory, and as bands are independent of each
+ * other it may convert several of them concurrently.
+ */
+
+#include "fb.h"
+#include "fbxv.h"
+#ifdef IN_MODULE
+#include "xf86_ansic.h"
+#endif
+#include "Xv.h"
+#include "fourcc.h"
+
+#if defined(__SSE2__) && !defined(IN_MODULE)
+#include <emmintrin.h>
+#define FB_XV_SSE2
+#endif
+
+#define FB_XV_MAX_WIDTH		4096
+#define FB_XV_MAX_HEIGHT	4096
+
+int
+fbXvImageAttributes (int		id,
+		     unsigned short	*w,
+		     unsigned short	*h,
+		     int		*pitches,
+		     int		*offsets)
+{
+    int	size, tmp;
+
+    if (*w > FB_XV_MAX_WIDTH)
+	*w = FB_XV_MAX_WIDTH;
+    if (*h > FB_XV_MAX_HEIGHT)
+	*h = FB_XV_MAX_HEIGHT;
+
+    *w = (*w + 1) & ~1;
+    if (offsets)
+	offsets[0] = 0;
+
+    switch (id) {
+    case FOURCC_YV12:
+    case FOURCC_I420:
+	*h = (*h + 1) & ~1;
+	size = (*w + 3) & ~3;
+	if (pitches)
+	    pitches[0] = size;
+	size *= *h;
+	if (offsets)
+	    offsets[1] = size;
+	tmp = ((*w >> 1) + 3) & ~3;
+	if (pitches)
+	    pitches[1] = pitches[2] = tmp;
+	tmp *= (*h >> 1);
+	size += tmp;
+	if (offsets)
+	    offsets[2] = size;
+	size += tmp;
+	break;
+    case FOURCC_YUY2:
+    case FOURCC_UYVY:
+	size = *w << 1;
+	if (pitches)
+	    pitches[0] = size;
+	size *= *h;
+	break;
+    default:
+	size = 0;
+	break;
+    }
+    return size;
+}
+
+Bool
+fbXvSetupSource (FbXvSourcePtr	pSrc,
+		 int		id,
+		 CARD8		*buf,
+		 int		width,
+		 int		height)
+{
+    unsigned short  w = width, h = height;
+    int		    pitches[3], offsets[3];
+
+    if (!fbXvImageAttributes (id, &w, &h, pitches, offsets))
+	return FALSE;
+    pSrc->id = id;
+    pSrc->width = width;
+    pSrc->height = height;
+    pSrc->planes[0] = buf;
+    pSrc->pitches[0] = pitches[0];
+    switch (id) {
+    case FOURCC_YV12:
+	pSrc->planes[1] = buf + offsets[2];
+	pSrc->planes[2] = buf + offsets[1];
+	pSrc->pitches[1] = pSrc->pitches[2] = pitches[1];
+	break;
+    case FOURCC_I420:
+	pSrc->planes[1] = buf + offsets[1];
+	pSrc->planes[2] = buf + offsets[2];
+	pSrc->pitches[1] = pSrc->pitches[2] = pitches[1];
+	break;
+    default:
+	pSrc->planes[1] = pSrc->planes[2] = 0;
+	pSrc->pitches[1] = pSrc->pitches[2] = 0;
+	break;
+    }
+    return TRUE;
+}
+
+static Bool
+fbXvMaskBits (Pixel mask, int *shift, int *bits)
+{
+    int	s = 0, b = 0;
+
+    if (!mask)
+	return FALSE;
+    while (!(mask & 1))
+    {
+	mask >>= 1;
+	s++;
+    }
+    while (mask & 1)
+    {
+	mask >>= 1;
+	b++;
+    }
+    if (mask || b > 8)
+	return FALSE;
+    *shift = s;
+    *bits = b;
+    return TRUE;
+}
+
+Bool
+fbXvSetupDest (FbXvDestPtr	pDst,
+	       int		bpp,
+	       Pixel		redMask,
+	       Pixel		greenMask,
+	       Pixel		blueMask)
+{
+    if (bpp != 16 && bpp != 24 && bpp != 32)
+	return FALSE;
+    if (!fbXvMaskBits (redMask, &pDst->rshift, &pDst->rbits) ||
+	!fbXvMaskBits (greenMask, &pDst->gshift, &pDst->gbits) ||
+	!fbXvMaskBits (blueMask, &pDst->bshift, &pDst->bbits))
+	return FALSE;
+    pDst->bpp = bpp;
+    pDst->x8r8g8b8 = (bpp == 32 &&
+		      redMask == 0xff0000 &&
+		      greenMask == 0x00ff00 &&
+		      blueMask == 0x0000ff);
+    return TRUE;
+}
+
+/*
+ * ITU-R BT.601 with 8 bits of fraction; results are x8r8g8b8
+ */
+#define FbXvClamp(c)	((c) < 0 ? 0 : (c) > 255 ? 255 : (c))
+
+static void
+fbXvYuvToRgb (CARD8 *y, CARD8 *u, CARD8 *v, CARD32 *rgb, int n)
+{
+    int	yy, uu, vv, r, g, b;
+
+    while (n--)
+    {
+	yy = (*y++ - 16) * 298 + 128;
+	uu = *u++ - 128;
+	vv = *v++ - 128;
+	r = (yy + 409 * vv) >> 8;
+	g = (yy - 100 * uu - 208 * vv) >> 8;
+	b = (yy + 516 * uu) >> 8;
+	*rgb++ = (FbXvClamp (r) << 16) | (FbXvClamp (g) << 8) | FbXvClamp (b);
+    }
+}
+
+#ifdef FB_XV_SSE2
+/*
+ * Eight pixels per iteration; the products are formed with pmaddwd on
+ * (luma, chroma) pairs so everything stays within 32 bits
+ */
+static void
+fbXvYuvToRgbSSE2 (CARD8 *y, CARD8 *u, CARD8 *v, CARD32 *rgb, int n)
+{
+    __m128i zero = _mm_setzero_si128 ();
+    __m128i c16 = _mm_set1_epi16 (16);
+    __m128i c128 = _mm_set1_epi16 (128);
+    __m128i round = _mm_set1_epi32 (128);
+    __m128i kR = _mm_set_epi16 (409, 298, 409, 298, 409, 298, 409, 298);
+    __m128i kB = _mm_set_epi16 (516, 298, 516, 298, 516, 298, 516, 298);
+    __m128i kG = _mm_set_epi16 (-100, 298, -100, 298, -100, 298, -100, 298);
+    __m128i kGv = _mm_set_epi16 (0, -208, 0, -208, 0, -208, 0, -208);
+    __m128i Y, U, V, yv, yu, vz;
+    __m128i rl, rh, gl, gh, bl, bh, r, g, b, bg, rz;
+
+    while (n >= 8)
+    {
+	Y = _mm_sub_epi16 (_mm_unpacklo_epi8 (_mm_loadl_epi64 ((__m128i *) y),
+					      zero), c16);
+	U = _mm_sub_epi16 (_mm_unpacklo_epi8 (_mm_loadl_epi64 ((__m128i *) u),
+					      zero), c128);
+	V = _mm_sub_epi16 (_mm_unpacklo_epi8 (_mm_loadl_epi64 ((__m128i *) v),
+					      zero), c128);
+
+	yv = _mm_unpacklo_epi16 (Y, V);
+	yu = _mm_unpacklo_epi16 (Y, U);
+	vz = _mm_unpacklo_epi16 (V, zero);
+	rl = _mm_srai_epi32 (_mm_add_epi32 (_mm_madd_epi16 (yv, kR), round), 8);
+	gl = _mm_srai_epi32 (_mm_add_epi32 (_mm_add_epi32 (_mm_madd_epi16 (yu, kG),
+							   _mm_madd_epi16 (vz, kGv)),
+					    round), 8);
+	bl = _mm_srai_epi32 (_mm_add_epi32 (_mm_madd_epi16 (yu, kB), round), 8);
+
+	yv = _mm_unpackhi_epi16 (Y, V);
+	yu = _mm_unpackhi_epi16 (Y, U);
+	vz = _mm_unpackhi_epi16 (V, zero);
+	rh = _mm_srai_epi32 (_mm_add_epi32 (_mm_madd_epi16 (yv, kR), round), 8);
+	gh = _mm_srai_epi32 (_mm_add_epi32 (_mm_add_epi32 (_mm_madd_epi16 (yu, kG),
+							   _mm_madd_epi16 (vz, kGv)),
+					    round), 8);
+	bh = _mm_srai_epi32 (_mm_add_epi32 (_mm_madd_epi16 (yu, kB), round), 8);
+
+	/* saturate to bytes and interleave into b, g, r, 0 */
+	r = _mm_packs_epi32 (rl, rh);
+	g = _mm_packs_epi32 (gl, gh);
+	b = _mm_packs_epi32 (bl, bh);
+	r = _mm_packus_epi16 (r, r);
+	g = _mm_packus_epi16 (g, g);
+	b = _mm_packus_epi16 (b, b);
+	bg = _mm_unpacklo_epi8 (b, g);
+	rz = _mm_unpacklo_epi8 (r, zero);
+	_mm_storeu_si128 ((__m128i *) rgb, _mm_unpacklo_epi16 (bg, rz));
+	_mm_storeu_si128 ((__m128i *) (rgb + 4), _mm_unpackhi_epi16 (bg, rz));
+
+	y += 8;
+	u += 8;
+	v += 8;
+	rgb += 8;
+	n -= 8;
+    }
+    fbXvYuvToRgb (y, u, v, rgb, n);
+}
+#define fbXvYuvToRgbRow	fbXvYuvToRgbSSE2
+#else
+#define fbXvYuvToRgbRow	fbXvYuvToRgb
+#endif
+
+#define fbXvPixel(d,c)	((((c) >> (24 - (d)->rbits)) & ((1 << (d)->rbits) - 1)) << (d)->rshift | \
+			 (((c) >> (16 - (d)->gbits)) & ((1 << (d)->gbits) - 1)) << (d)->gshift | \
+			 (((c) >> (8 - (d)->bbits)) & ((1 << (d)->bbits) - 1)) << (d)->bshift)
+
+static void
+fbXvStoreRow (FbXvDestPtr pDst, CARD32 *rgb, CARD8 *dst, int n)
+{
+    CARD32  pixel;
+
+    switch (pDst->bpp) {
+    case 16:
+	{
+	    CARD16  *d = (CARD16 *) dst;
+
+	    while (n--)
+	    {
+		pixel = *rgb++;
+		*d++ = fbXvPixel (pDst, pixel);
+	    }
+	}
+	break;
+    case 24:
+	while (n--)
+	{
+	    pixel = *rgb++;
+	    pixel = fbXvPixel (pDst, pixel);
+#if IMAGE_BYTE_ORDER == MSBFirst
+	    dst[0] = pixel >> 16;
+	    dst[1] = pixel >> 8;
+	    dst[2] = pixel;
+#else
+	    dst[0] = pixel;
+	    dst[1] = pixel >> 8;
+	    dst[2] = pixel >> 16;
+#endif
+	    dst += 3;
+	}
+	break;
+    case 32:
+	{
+	    CARD32  *d = (CARD32 *) dst;
+
+	    while (n--)
+	    {
+		pixel = *rgb++;
+		*d++ = fbXvPixel (pDst, pixel);
+	    }
+	}
+	break;
+    }
+}
+
+/*
+ * Convert destination rows [y1, y2) of a dw x dh scaling of the source
+ * rectangle.  dst addresses row y1.  Scaling picks the nearest sample
+ * with 16.16 fixed point accumulators, stepped per pixel and per row so
+ * nothing is ever multiplied by a step; chroma is taken from the sample
+ * pair covering the luma sample.
+ */
+Bool
+fbXvConvertBand (FbXvSourcePtr	pSrc,
+		 int		sx,
+		 int		sy,
+		 int		sw,
+		 int		sh,
+		 FbXvDestPtr	pDst,
+		 CARD8		*dst,
+		 int		dstStride,
+		 int		dw,
+		 int		dh,
+		 int		y1,
+		 int		y2)
+{
+    CARD32	    *rgb;
+    int		    *xmap;
+    CARD8	    *ybuf, *ubuf, *vbuf, *yrow;
+    CARD8	    *line, *pair;
+    unsigned long   xstep, ystep, acc, yacc;
+    int		    x, y, row, srow, xs;
+
+    if (dw <= 0 || dh <= 0 || sw <= 0 || sh <= 0)
+	return TRUE;
+    rgb = (CARD32 *) xalloc (dw * (sizeof (CARD32) + sizeof (int) + 3));
+    if (!rgb)
+	return FALSE;
+    xmap = (int *) (rgb + dw);
+    ybuf = (CARD8 *) (xmap + dw);
+    ubuf = ybuf + dw;
+    vbuf = ubuf + dw;
+
+    xstep = ((unsigned long) sw << 16) / dw;
+    ystep = ((unsigned long) sh << 16) / dh;
+    acc = xstep >> 1;
+    for (x = 0; x < dw; x++)
+    {
+	xmap[x] = sx + (acc >> 16);
+	acc += xstep;
+    }
+
+    /* y1 * ystep, split so the product of the fractions can't overflow */
+    srow = y1 * (int) (ystep >> 16);
+    yacc = (unsigned long) y1 * (ystep & 0xffff);
+    srow += yacc >> 16;
+    yacc = (yacc & 0xffff) + (ystep >> 1);
+    srow += yacc >> 16;
+    yacc &= 0xffff;
+
+    for (y = y1; y < y2; y++)
+    {
+	row = sy + (srow < sh ? srow : sh - 1);
+	yacc += ystep;
+	srow += yacc >> 16;
+	yacc &= 0xffff;
+	yrow = ybuf;
+	switch (pSrc->id) {
+	case FOURCC_YV12:
+	case FOURCC_I420:
+	    line = pSrc->planes[0] + row * pSrc->pitches[0];
+	    if (sw == dw)
+		yrow = line + sx;
+	    else
+		for (x = 0; x < dw; x++)
+		    ybuf[x] = line[xmap[x]];
+	    row >>= 1;
+	    line = pSrc->planes[1] + row * pSrc->pitches[1];
+	    for (x = 0; x < dw; x++)
+		ubuf[x] = line[xmap[x] >> 1];
+	    line = pSrc->planes[2] + row * pSrc->pitches[2];
+	    for (x = 0; x < dw; x++)
+		vbuf[x] = line[xmap[x] >> 1];
+	    break;
+	case FOURCC_YUY2:
+	    line = pSrc->planes[0] + row * pSrc->pitches[0];
+	    for (x = 0; x < dw; x++)
+	    {
+		xs = xmap[x];
+		pair = line + ((xs >> 1) << 2);
+		ybuf[x] = line[xs << 1];
+		ubuf[x] = pair[1];
+		vbuf[x] = pair[3];
+	    }
+	    break;
+	case FOURCC_UYVY:
+	    line = pSrc->planes[0] + row * pSrc->pitches[0];
+	    for (x = 0; x < dw; x++)
+	    {
+		xs = xmap[x];
+		pair = line + ((xs >> 1) << 2);
+		ybuf[x] = line[(xs << 1) + 1];
+		ubuf[x] = pair[0];
+		vbuf[x] = pair[2];
+	    }
+	    break;
+	}
+	if (pDst->x8r8g8b8)
+	    fbXvYuvToRgbRow (yrow, ubuf, vbuf, (CARD32 *) dst, dw);
+	else
+	{
+	    fbXvYuvToRgbRow (yrow, ubuf, vbuf, rgb, dw);
+	    fbXvStoreRow (pDst, rgb, dst, dw);
+	}
+	dst += dstStride;
+    }
+    xfree (rgb);
+    return TRUE;
+}
+
+#ifdef XV
+
+#include "dixstruct.h"
+#include "xvdix.h"
+
+#define FB_XV_NUM_PORTS	    16
+#define FB_XV_BAND_BYTES    (64 * 1024)
+
+static XvImageRec fbXvImages[] = {
+    XVIMAGE_YV12,
+    XVIMAGE_I420,
+    XVIMAGE_YUY2,
+    XVIMAGE_UYVY
+};
+
+#define FB_XV_NUM_IMAGES    (sizeof (fbXvImages) / sizeof (fbXvImages[0]))
+
+typedef struct _FbXvScreenPriv {
+    CARD8	*band;
+    int		bandSize;
+} FbXvScreenPrivRec, *FbXvScreenPrivPtr;
+
+static int fbXvScreenIndex;
+
+#define fbXvGetScreen(s)    ((XvScreenPtr) \
+			     (s)->devPrivates[fbXvScreenIndex].ptr)
+
+static VisualPtr
+fbXvDrawableVisual (DrawablePtr pDraw)
+{
+    ScreenPtr	pScreen = pDraw->pScreen;
+    VisualPtr	pVisual;
+    VisualID	vid = 0;
+    int		i;
+
+    if (pDraw->type == DRAWABLE_WINDOW)
+	vid = wVisual ((WindowPtr) pDraw);
+    for (i = 0, pVisual = pScreen->visuals; i < pScreen->numVisuals; i++, pVisual++)
+    {
+	if (vid ? pVisual->vid != vid : pVisual->nplanes != pDraw->depth)
+	    continue;
+	if (pVisual->class == TrueColor)
+	    return pVisual;
+	if (vid)
+	    break;
+    }
+    return 0;
+}
+
+static int
+fbXvAllocatePort (unsigned long port, XvPortPtr pPort, XvPortPtr *ppPort)
+{
+    *ppPort = pPort;
+    return Success;
+}
+
+static int
+fbXvFreePort (XvPortPtr pPort)
+{
+    return Success;
+}
+
+static int
+fbXvNoVideo (ClientPtr client, DrawablePtr pDraw, XvPortPtr pPort, GCPtr pGC,
+	     INT16 vid_x, INT16 vid_y, CARD16 vid_w, CARD16 vid_h,
+	     INT16 drw_x, INT16 drw_y, CARD16 drw_w, CARD16 drw_h)
+{
+    return BadMatch;
+}
+
+static int
+fbXvStopVideo (ClientPtr client, XvPortPtr pPort, DrawablePtr pDraw)
+{
+    return Success;
+}
+
+static int
+fbXvSetPortAttribute (ClientPtr client, XvPortPtr pPort, Atom attribute,
+		      INT32 value)
+{
+    return BadMatch;
+}
+
+static int
+fbXvGetPortAttribute (ClientPtr client, XvPortPtr pPort, Atom attribute,
+		      INT32 *p_value)
+{
+    return BadMatch;
+}
+
+static int
+fbXvQueryBestSize (ClientPtr client, XvPortPtr pPort, CARD8 motion,
+		   CARD16 vid_w, CARD16 vid_h, CARD16 drw_w, CARD16 drw_h,
+		   unsigned int *p_w, unsigned int *p_h)
+{
+    *p_w = drw_w;
+    *p_h = drw_h;
+    return Success;
+}
+
+static int
+fbXvQueryImageAttributes (ClientPtr client, XvPortPtr pPort, XvImagePtr format,
+			  CARD16 *width, CARD16 *height,
+			  int *pitches, int *offsets)
+{
+    return fbXvImageAttributes (format->id, width, height, pitches, offsets);
+}
+
+static int
+fbXvPutImage (ClientPtr client, DrawablePtr pDraw, XvPortPtr pPort, GCPtr pGC,
+	      INT16 src_x, INT16 src_y, CARD16 src_w, CARD16 src_h,
+	      INT16 drw_x, INT16 drw_y, CARD16 drw_w, CARD16 drw_h,
+	      XvImagePtr format, unsigned char *data, Bool sync,
+	      CARD16 width, CARD16 height)
+{
+    FbXvScreenPrivPtr	pPriv = (FbXvScreenPrivPtr) pPort->pAdaptor->devPriv.ptr;
+    VisualPtr		pVisual;
+    FbXvSourceRec	src;
+    FbXvDestRec		dst;
+    int			sx1, sy1, sx2, sy2;
+    int			stride, band, y, h;
+
+    if (width > FB_XV_MAX_WIDTH || height > FB_XV_MAX_HEIGHT)
+	return BadValue;
+
+    /* clip the source rectangle to the image */
+    sx1 = src_x < 0 ? 0 : src_x;
+    sy1 = src_y < 0 ? 0 : src_y;
+    sx2 = src_x + src_w > width ? width : src_x + src_w;
+    sy2 = src_y + src_h > height ? height : src_y + src_h;
+    if (sx1 >= sx2 || sy1 >= sy2)
+	return Success;
+
+    pVisual = fbXvDrawableVisual (pDraw);
+    if (!pVisual)
+	return BadMatch;
+    if (!fbXvSetupSource (&src, format->id, data, width, height) ||
+	!fbXvSetupDest (&dst, BitsPerPixel (pDraw->depth),
+			pVisual->redMask, pVisual->greenMask, pVisual->blueMask))
+	return BadMatch;
+
+    stride = PixmapBytePad (drw_w, pDraw->depth);
+    band = FB_XV_BAND_BYTES / stride;
+    if (band < 1)
+	band = 1;
+    if (band > drw_h)
+	band = drw_h;
+    if (pPriv->bandSize < band * stride)
+    {
+	CARD8	*b = (CARD8 *) xrealloc (pPriv->band, band * stride);
+
+	if (!b)
+	    return BadAlloc;
+	pPriv->band = b;
+	pPriv->bandSize = band * stride;
+    }
+
+    for (y = 0; y < drw_h; y += h)
+    {
+	h = drw_h - y;
+	if (h > band)
+	    h = band;
+	if (!fbXvConvertBand (&src, sx1, sy1, sx2 - sx1, sy2 - sy1,
+			      &dst, pPriv->band, stride,
+			      drw_w, drw_h, y, y + h))
+	    return BadAlloc;
+	(*pGC->ops->PutImage) (pDraw, pGC, pDraw->depth,
+			       drw_x, drw_y + y, drw_w, h,
+			       0, ZPixmap, (char *) pPriv->band);
+    }
+    return Success;
+}
+
+static void
+fbXvFreeAdaptor (XvAdaptorPtr pa)
+{
+    FbXvScreenPrivPtr	pPriv = (FbXvScreenPrivPtr) pa->devPriv.ptr;
+
+    if (pPriv)
+    {
+	if (pPriv->band)
+	    xfree (pPriv->band);
+	xfree (pPriv);
+    }
+    if (pa->pEncodings)
+	xfree (pa->pEncodings);
+    if (pa->pFormats)
+	xfree (pa->pFormats);
+    if (pa->pPorts)
+	xfree (pa->pPorts);
+    xfree (pa);
+}
+
+static Bool
+fbXvCloseScreen (int i, ScreenPtr pScreen)
+{
+    XvScreenPtr		pxvs = fbXvGetScreen (pScreen);
+
+    if (pxvs->pAdaptors)
+	fbXvFreeAdaptor (pxvs->pAdaptors);
+    pxvs->pAdaptors = 0;
+    pxvs->nAdaptors = 0;
+    return TRUE;
+}
+
+static int
+fbXvQueryAdaptors (ScreenPtr pScreen, XvAdaptorPtr *p_pAdaptors,
+		   int *p_nAdaptors)
+{
+    XvScreenPtr	pxvs = fbXvGetScreen (pScreen);
+
+    *p_nAdaptors = pxvs->nAdaptors;
+    *p_pAdaptors = pxvs->pAdaptors;
+    return Success;
+}
+
+static Bool
+fbXvInitAdaptor (ScreenPtr pScreen, XvAdaptorPtr pa)
+{
+    FbXvScreenPrivPtr	pPriv;
+    XvEncodingPtr	pe;
+    XvFormatPtr		pf;
+    XvPortPtr		pp;
+    VisualPtr		pVisual;
+    unsigned long	PortResource = XvGetRTPort ();
+    int			i, n;
+
+    pa->type = XvInputMask | XvImageMask;
+    pa->name = "FB Software Video";
+    pa->pScreen = pScreen;
+
+    pPriv = (FbXvScreenPrivPtr) xalloc (sizeof (FbXvScreenPrivRec));
+    if (!pPriv)
+	return FALSE;
+    pPriv->band = 0;
+    pPriv->bandSize = 0;
+    pa->devPriv.ptr = (pointer) pPriv;
+
+    pe = (XvEncodingPtr) xalloc (sizeof (XvEncodingRec));
+    if (!pe)
+	return FALSE;
+    pe->id = 0;
+    pe->pScreen = pScreen;
+    pe->name = "XV_IMAGE";
+    pe->width = FB_XV_MAX_WIDTH;
+    pe->height = FB_XV_MAX_HEIGHT;
+    pe->rate.numerator = 1;
+    pe->rate.denominator = 1;
+    pa->nEncodings = 1;
+    pa->pEncodings = pe;
+
+    pf = (XvFormatPtr) xalloc (pScreen->numVisuals * sizeof (XvFormatRec));
+    if (!pf)
+	return FALSE;
+    pa->pFormats = pf;
+    n = 0;
+    for (i = 0, pVisual = pScreen->visuals; i < pScreen->numVisuals; i++, pVisual++)
+    {
+	FbXvDestRec dst;
+
+	if (pVisual->class != TrueColor ||
+	    !fbXvSetupDest (&dst, BitsPerPixel (pVisual->nplanes),
+			    pVisual->redMask, pVisual->greenMask,
+			    pVisual->blueMask))
+	    continue;
+	pf[n].depth = pVisual->nplanes;
+	pf[n].visual = pVisual->vid;
+	n++;
+    }
+    if (!n)
+	return FALSE;
+    pa->nFormats = n;
+
+    pa->nAttributes = 0;
+    pa->pAttributes = 0;
+    pa->nImages = FB_XV_NUM_IMAGES;
+    pa->pImages = fbXvImages;
+
+    /* AddResource calls ddFreePort on failure */
+    pa->ddAllocatePort = fbXvAllocatePort;
+    pa->ddFreePort = fbXvFreePort;
+
+    pp = (XvPortPtr) xcalloc (FB_XV_NUM_PORTS, sizeof (XvPortRec));
+    if (!pp)
+	return FALSE;
+    pa->pPorts = pp;
+    for (i = 0; i < FB_XV_NUM_PORTS; i++, pp++)
+    {
+	if (!(pp->id = FakeClientID (0)))
+	    break;
+	pp->pAdaptor = pa;
+	pp->time = currentTime;
+	if (!AddResource (pp->id, PortResource, pp))
+	    break;
+    }
+    if (!i)
+	return FALSE;
+    pa->nPorts = i;
+    pa->base_id = pa->pPorts[0].id;
+
+    pa->ddPutVideo = fbXvNoVideo;
+    pa->ddPutStill = fbXvNoVideo;
+    pa->ddGetVideo = fbXvNoVideo;
+    pa->ddGetStill = fbXvNoVideo;
+    pa->ddStopVideo = fbXvStopVideo;
+    pa->ddSetPortAttribute = fbXvSetPortAttribute;
+    pa->ddGetPortAttribute = fbXvGetPortAttribute;
+    pa->ddQueryBestSize = fbXvQueryBestSize;
+    pa->ddPutImage = fbXvPutImage;
+    pa->ddQueryImageAttributes = fbXvQueryImageAttributes;
+    return TRUE;
+}
+
+/*
+ * Register a single image adaptor for every TrueColor visual of 16, 24
+ * or 32 bits per pixel.  Images arriving through XvShmPutImage are
+ * converted straight out of the shared segment.
+ */
+Bool
+fbXvScreenInit (ScreenPtr pScreen)
+{
+    XvScreenPtr	    pxvs;
+    XvAdaptorPtr    pa;
+
+    if (XvScreenInit (pScreen) != Success)
+	return FALSE;
+    fbXvScreenIndex = XvGetScreenIndex ();
+    pxvs = fbXvGetScreen (pScreen);
+    pxvs->nAdaptors = 0;
+    pxvs->pAdaptors = 0;
+    pxvs->ddCloseScreen = fbXvCloseScreen;
+    pxvs->ddQueryAdaptors = fbXvQueryAdaptors;
+
+    pa = (XvAdaptorPtr) xcalloc (1, sizeof (XvAdaptorRec));
+    if (!pa)
+	return FALSE;
+    if (!fbXvInitAdaptor (pScreen, pa))
+    {
+	/* no port resource is registered on any failure path */
+	fbXvFreeAdaptor (pa);
+	return FALSE;
+    }
+    pxvs->pAdaptors = pa;
+    pxvs->nAdaptors = 1;
+    return TRUE;
+}
+
+#endif /* XV */
@@ -0,0 +1,70 @@
+/*
+   Copyright (c) 2003  XFree86 Inc
+*/
+/* $XFree86$ */
+
+#ifndef _FBXV_H_
+#define _FBXV_H_
+
+/*
+ * Source image description; planar formats keep the Y, U and V planes
+ * in planes[0..2] whatever their order in the client buffer, packed
+ * formats use planes[0] only.
+ */
+typedef struct _FbXvSource {
+    int		id;
+    int		width, height;
+    CARD8	*planes[3];
+    int		pitches[3];
+} FbXvSourceRec, *FbXvSourcePtr;
+
+/*
+ * Destination pixel layout, derived from a TrueColor visual
+ */
+typedef struct _FbXvDest {
+    int		bpp;
+    int		rshift, rbits;
+    int		gshift, gbits;
+    int		bshift, bbits;
+    Bool	x8r8g8b8;
+} FbXvDestRec, *FbXvDestPtr;
+
+int
+fbXvImageAttributes (int		id,
+		     unsigned short	*w,
+		     unsigned short	*h,
+		     int		*pitches,
+		     int		*offsets);
+
+Bool
+fbXvSetupSource (FbXvSourcePtr	pSrc,
+		 int		id,
+		 CARD8		*buf,
+		 int		width,
+		 int		height);
+
+Bool
+fbXvSetupDest (FbXvDestPtr	pDst,
+	       int		bpp,
+	       Pixel		redMask,
+	       Pixel		greenMask,
+	       Pixel		blueMask);
+
+Bool
+fbXvConvertBand (FbXvSourcePtr	pSrc,
+		 int		sx,
+		 int		sy,
+		 int		sw,
+		 int		sh,
+		 FbXvDestPtr	pDst,
+		 CARD8		*dst,
+		 int		dstStride,
+		 int		dw,
+		 int		dh,
+		 int		y1,
+		 int		y2);
+
+Bool
+fbXvScreenInit (ScreenPtr pScreen);
+
+#endif /* _FBXV_H_ */
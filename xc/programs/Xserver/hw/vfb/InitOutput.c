@@ -40,11 +40,15 @@ from The Open Group.
 #include "servermd.h"
 #define PSZ 8
 #include "fb.h"
+#ifdef XV
+#include "fbxv.h"
+#endif
 #include "mibstore.h"
 #include "colormapst.h"
 #include "gcstruct.h"
 #include "input.h"
 #include "mipointer.h"
+#include "misprite.h"
 #include <sys/types.h>
 #ifdef HAS_MMAP
 #include <sys/mman.h>
@@ -114,6 +118,7 @@ static fbMemType fbmemtype = NORMAL_MEMORY_FB;
 static char needswap = 0;
 static int lastScreen = -1;
 static Bool Render = TRUE;
+static Bool fbCursor = TRUE;
 
 #define swapcopy16(_dst, _src) \
     if (needswap) { CARD16 _s = _src; cpswaps(_s, _dst); } \
@@ -261,6 +266,8 @@ ddxUseMsg()
     ErrorF("+/-render		   turn on/of RENDER extension support"
 	   "(default on)\n");
 #endif
+    ErrorF("+/-fbcursor            draw the cursor into the framebuffer"
+	   " (default on)\n");
     ErrorF("-linebias n            adjust thin line pixelization\n");
     ErrorF("-blackpixel n          pixel value for black\n");
     ErrorF("-whitepixel n          pixel value for white\n");
@@ -344,6 +351,18 @@ ddxProcessArgument (argc, argv, i)
 	return 1;
     }
 
+    if (strcmp (argv[i], "+fbcursor") == 0)	/* +fbcursor */
+    {
+	fbCursor = TRUE;
+	return 1;
+    }
+
+    if (strcmp (argv[i], "-fbcursor") == 0)	/* -fbcursor */
+    {
+	fbCursor = FALSE;
+	return 1;
+    }
+
     if (strcmp (argv[i], "-blackpixel") == 0)	/* -blackpixel n */
     {
 	Pixel pix;
@@ -945,6 +964,10 @@ vfbScreenInit(index, pScreen, argc, argv)
 #ifdef RENDER
 	if (ret && Render) 
 	    fbPictureInit (pScreen, 0, 0);
+#endif
+#ifdef XV
+	if (ret && pvfb->bitsPerPixel != 8)
+	    fbXvScreenInit (pScreen);
 #endif
 	break;
     default:
@@ -971,6 +994,8 @@ vfbScreenInit(index, pScreen, argc, argv)
     pScreen->StoreColors = vfbStoreColors;
 
     miDCInitialize(pScreen, &vfbPointerCursorFuncs);
+    if (!fbCursor)
+	miSpriteSetReadout(pScreen, TRUE);
 
     vfbWriteXWDFileHeader(pScreen);
 
@@ -63,6 +63,9 @@
 
 extern Selection *CurrentSelections;
 extern int NumCurrentSelections;
+#ifdef XRECORD
+extern int RecordRingSize;
+#endif
 
 /* DIX things */
 
@@ -109,6 +112,7 @@ LOOKUP dixLookupTab[] = {
   /* dixfonts.c */
   SYMFUNC(CloseFont)
   SYMFUNC(FontToXError)
+  SYMFUNC(GetFontNameCacheStatistics)
   SYMFUNC(LoadGlyphs)
   SYMVAR(fpe_functions)
   /* dixutils.c */
@@ -307,6 +311,7 @@ LOOKUP dixLookupTab[] = {
   SYMVAR(ReplyCallback)
   SYMVAR(SkippedRequestsCallback)
   SYMFUNC(ResetCurrentRequest)
+  SYMFUNC(ClientIsWriteBlocked)
   /* connection.c */
   SYMFUNC(IgnoreClient)
   SYMFUNC(AttendClient)
@@ -318,6 +323,9 @@ LOOKUP dixLookupTab[] = {
   /* utils.c */
   SYMFUNC(AdjustWaitForDelay)
   SYMVAR(noTestExtensions)
+#ifdef XRECORD
+  SYMVAR(RecordRingSize)
+#endif
 
   /* devices.c */
   SYMFUNC(InitPointerDeviceStruct)
@@ -21,6 +21,8 @@ LOOKUP fontLookupTab[] = {
   SYMFUNC(FontCouldBeTerminal)
   SYMFUNC(BufFileRead)
   SYMFUNC(BufFileWrite)
+  SYMFUNC(BufFileMapRead)
+  SYMFUNC(BufFileUnmap)
   SYMFUNC(CheckFSFormat)
   SYMFUNC(FontFileOpen)
   SYMFUNC(FontFilePriorityRegisterRenderer)
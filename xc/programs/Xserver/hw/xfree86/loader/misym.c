@@ -30,6 +30,7 @@
 #include "mibstore.h"
 #include "cursor.h"
 #include "mipointer.h"
+#include "misprite.h"
 #include "migc.h"
 #include "miline.h"
 #include "mizerarc.h"
@@ -130,6 +131,10 @@ LOOKUP miLookupTab[] = {
    SYMFUNC(miRecolorCursor)
    SYMFUNC(miPointerWarpCursor)
    SYMFUNC(miDCInitialize)
+   SYMFUNC(miSpriteSetReadout)
+   SYMFUNC(miSpriteReadout)
+   SYMFUNC(miSpriteReadoutBegin)
+   SYMFUNC(miSpriteReadoutEnd)
    SYMFUNC(miRectsToRegion)
    SYMFUNC(miPointInRegion)
    SYMFUNC(miInverse)
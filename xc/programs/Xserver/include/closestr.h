@@ -58,6 +58,9 @@ typedef struct _OFclosure {
     char       *fontname;
     int         fnamelen;
     FontPtr	non_cachable_font;
+    char       *reqname;	/* name as requested, for the name cache */
+    int		reqnamelen;
+    Bool	fromCache;	/* fontname was taken from the name cache */
 }           OFclosureRec;
 
 /* ListFontsWithInfo */
@@ -127,6 +127,12 @@ extern void InitFonts(void);
 
 extern void FreeFonts(void);
 
+extern void GetFontNameCacheStatistics(unsigned long * /*openHits*/,
+				       unsigned long * /*openMisses*/,
+				       unsigned long * /*listHits*/,
+				       unsigned long * /*listMisses*/,
+				       unsigned long * /*flushes*/);
+
 extern FontPtr find_old_font(XID /*id*/);
 
 extern void GetGlyphs(FontPtr     /*font*/,
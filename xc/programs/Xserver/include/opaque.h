@@ -58,6 +58,7 @@ extern char *display;
 extern int defaultBackingStore;
 extern Bool disableBackingStore;
 extern Bool enableBackingStore;
+extern unsigned long backingStoreLimit;
 extern Bool disableSaveUnders;
 extern Bool PartialNetwork;
 #ifndef NOLOGOHACK
@@ -75,6 +76,7 @@ extern int limitNoFile;
 extern Bool permitOldBugs;
 extern Bool defeatAccessControl;
 extern char* protNoListen;
+extern int ListenBacklog;
 extern Bool blackRoot;
 
 
@@ -167,6 +167,12 @@ extern void SetCriticalOutputPending(
 #endif
 );
 
+extern Bool ClientIsWriteBlocked(
+#if NeedFunctionPrototypes
+    ClientPtr /*who*/
+#endif
+);
+
 extern int WriteToClient(
 #if NeedFunctionPrototypes
     ClientPtr /*who*/,
@@ -227,5 +227,6 @@ extern ScreenSaverStuffRec savedScreenInfo[MAXSCREENS];
 
 extern int numSaveUndersViewable;
 extern int deltaSaveUndersViewable;
+extern unsigned long windowTreeSerial;
 
 #endif /* WINDOWSTRUCT_H */
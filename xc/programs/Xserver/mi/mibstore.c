@@ -57,6 +57,8 @@ implied warranty.
 #include "fontstruct.h"
 #include "dixfontstr.h"
 #include "dixstruct.h"		/* For requestingClient */
+#include "servermd.h"
+#include "opaque.h"
 #include "mi.h"
 #include "mibstorest.h"
 
@@ -139,6 +141,10 @@ implied warranty.
    
 static void	    miCreateBSPixmap(WindowPtr pWin, BoxPtr pExtents);
 static void	    miDestroyBSPixmap(WindowPtr pWin);
+static PixmapPtr    miBSCreatePixmap(WindowPtr pWin, int w, int h);
+static void	    miBSSetPixmap(WindowPtr pWin, PixmapPtr pPixmap);
+static void	    miBSTouch(miBSWindowPtr pBackingStore);
+static void	    miBSPixmapBox(WindowPtr pWin, BoxPtr pBox);
 static void	    miTileVirtualBS(WindowPtr pWin);
 static void	    miBSAllocate(WindowPtr pWin), miBSFree(WindowPtr pWin);
 static Bool	    miBSCreateGCPrivate(GCPtr pGC);
@@ -2584,6 +2590,9 @@ miBSAllocate(pWin)
 	pBackingStore->pBackingPixmap = NullPixmap;
 	pBackingStore->x = 0;
 	pBackingStore->y = 0;
+	pBackingStore->pWin = pWin;
+	pBackingStore->pixmapBytes = 0;
+	pBackingStore->lruPrev = pBackingStore->lruNext = NULL;
 	REGION_INIT( pScreen, &pBackingStore->SavedRegion, NullBox, 1);
 	pBackingStore->viewable = (char)pWin->viewable;
 	pBackingStore->status = StatusNoPixmap;
@@ -2714,23 +2723,33 @@ miResizeBackingStore(
     GC	   *pGC;
     BoxPtr  extents;
     PixmapPtr pNewPixmap;
+    BoxRec  box;
     int nx, ny;
     int	nw, nh;
+    int	pw, ph;
 
     pBackingStore = (miBSWindowPtr)(pWin->backStorage);
     pBackingPixmap = pBackingStore->pBackingPixmap;
     if (!pBackingPixmap)
 	return;
     pScreen = pWin->drawable.pScreen;
-    extents = REGION_EXTENTS(pScreen, &pBackingStore->SavedRegion);
+    extents = &box;
+    miBSPixmapBox (pWin, extents);
     pNewPixmap = pBackingPixmap;
 
     nw = extents->x2 - extents->x1;
     nh = extents->y2 - extents->y1;
+    pw = pBackingPixmap->drawable.width;
+    ph = pBackingPixmap->drawable.height;
 
-    /* the policy here could be more sophisticated */
-    if (nw != pBackingPixmap->drawable.width ||
-	nh != pBackingPixmap->drawable.height)
+    /*
+     * Keep the pixmap while it still covers the window and saved
+     * region and isn't more than twice the size needed
+     */
+    if (extents->x1 < pBackingStore->x || extents->y1 < pBackingStore->y ||
+	extents->x2 > pBackingStore->x + pw ||
+	extents->y2 > pBackingStore->y + ph ||
+	(long) pw * ph > 2L * nw * nh)
     {
 	if (!saveBits || !nw || !nh)
 	{
@@ -2739,10 +2758,7 @@ miResizeBackingStore(
 	}
 	else
 	{
-	    pNewPixmap = (PixmapPtr)(*pScreen->CreatePixmap)
-					    (pScreen,
-					     nw, nh,
-					     pWin->drawable.depth);
+	    pNewPixmap = miBSCreatePixmap (pWin, nw, nh);
 	    if (!pNewPixmap)
 	    {
 #ifdef BSEAGER
@@ -2760,10 +2776,18 @@ miResizeBackingStore(
     }
     else
     {
-    	nx = pBackingStore->x - extents->x1 + dx;
-    	ny = pBackingStore->y - extents->y1 + dy;
-    	pBackingStore->x = extents->x1;
-    	pBackingStore->y = extents->y1;
+	if (pNewPixmap == pBackingPixmap)
+	{
+	    nx = dx;
+	    ny = dy;
+	}
+	else
+	{
+	    nx = pBackingStore->x - extents->x1 + dx;
+	    ny = pBackingStore->y - extents->y1 + dy;
+	    pBackingStore->x = extents->x1;
+	    pBackingStore->y = extents->y1;
+	}
     	
     	if (saveBits && (pNewPixmap != pBackingPixmap || nx != 0 || ny != 0))
     	{
@@ -2789,10 +2813,7 @@ miResizeBackingStore(
     /* SavedRegion is used in the backingGC clip; force an update */
     pWin->drawable.serialNumber = NEXT_SERIAL_NUMBER;
     if (pNewPixmap != pBackingPixmap)
-    {
-	(* pScreen->DestroyPixmap)(pBackingPixmap);
-	pBackingStore->pBackingPixmap = pNewPixmap;
-    }
+	miBSSetPixmap (pWin, pNewPixmap);
 }
 
 /*-
@@ -2850,6 +2871,7 @@ miBSSaveDoomedAreas(pWin, pObscured, dx, dy)
     if (REGION_NOTEMPTY(pScreen, pObscured))
     {
 	BoxRec	oldExtents;
+	miBSTouch (pBackingStore);
 	x = pWin->drawable.x;
 	y = pWin->drawable.y;
 	REGION_TRANSLATE(pScreen, pObscured, -x, -y);
@@ -2967,11 +2989,12 @@ miBSRestoreAreas(pWin, prgnExposed)
 					  pWin);
 	    /*
 	     * if the saved region is completely empty, dispose of the
-	     * backing pixmap, otherwise, retranslate the saved
-	     * region to window relative
+	     * backing pixmap unless a memory limit will reclaim it,
+	     * otherwise, retranslate the saved region to window relative
 	     */
 
-	    if (REGION_NOTEMPTY(pScreen, prgnSaved))
+	    miBSTouch (pBackingStore);
+	    if (REGION_NOTEMPTY(pScreen, prgnSaved) || backingStoreLimit)
 	    {
 		REGION_TRANSLATE(pScreen, prgnSaved,
 					     -pWin->drawable.x,
@@ -3656,6 +3679,141 @@ miBSDestroyClip(pGC)
     FUNC_EPILOGUE (pGC, pPriv);
 }
 
+/*
+ * Backing pixmaps are accounted against backingStoreLimit.  Windows
+ * holding one are kept on a list ordered by when their backing store
+ * was last saved to or restored from; when a new pixmap would go over
+ * the limit, the least recently used windows lose their saved contents,
+ * which are then exposed normally when they become visible.
+ */
+
+static miBSWindowPtr	miBSLRUHead, miBSLRUTail;
+static unsigned long	miBSPixmapBytes;
+
+static void
+miBSUnlink (pBackingStore)
+    miBSWindowPtr   pBackingStore;
+{
+    if (pBackingStore->lruPrev)
+	pBackingStore->lruPrev->lruNext = pBackingStore->lruNext;
+    else
+	miBSLRUHead = pBackingStore->lruNext;
+    if (pBackingStore->lruNext)
+	pBackingStore->lruNext->lruPrev = pBackingStore->lruPrev;
+    else
+	miBSLRUTail = pBackingStore->lruPrev;
+    pBackingStore->lruPrev = pBackingStore->lruNext = NULL;
+}
+
+static void
+miBSLink (pBackingStore)
+    miBSWindowPtr   pBackingStore;
+{
+    pBackingStore->lruPrev = NULL;
+    pBackingStore->lruNext = miBSLRUHead;
+    if (miBSLRUHead)
+	miBSLRUHead->lruPrev = pBackingStore;
+    else
+	miBSLRUTail = pBackingStore;
+    miBSLRUHead = pBackingStore;
+}
+
+static void
+miBSTouch (pBackingStore)
+    miBSWindowPtr   pBackingStore;
+{
+    if (!pBackingStore->pixmapBytes || miBSLRUHead == pBackingStore)
+	return;
+    miBSUnlink (pBackingStore);
+    miBSLink (pBackingStore);
+}
+
+/*
+ * The area a backing pixmap should cover: the whole window plus
+ * anything saved outside it, window relative
+ */
+static void
+miBSPixmapBox (pWin, pBox)
+    WindowPtr	pWin;
+    BoxPtr	pBox;
+{
+    miBSWindowPtr   pBackingStore = (miBSWindowPtr) pWin->backStorage;
+    BoxPtr	    extents;
+
+    pBox->x1 = 0;
+    pBox->y1 = 0;
+    pBox->x2 = pWin->drawable.width;
+    pBox->y2 = pWin->drawable.height;
+    extents = REGION_EXTENTS(pWin->drawable.pScreen,
+			     &pBackingStore->SavedRegion);
+    if (extents->x1 == extents->x2 || extents->y1 == extents->y2)
+	return;
+    if (extents->x1 < pBox->x1) pBox->x1 = extents->x1;
+    if (extents->y1 < pBox->y1) pBox->y1 = extents->y1;
+    if (extents->x2 > pBox->x2) pBox->x2 = extents->x2;
+    if (extents->y2 > pBox->y2) pBox->y2 = extents->y2;
+}
+
+static PixmapPtr
+miBSCreatePixmap (pWin, w, h)
+    WindowPtr	pWin;
+    int		w, h;
+{
+    ScreenPtr	    pScreen = pWin->drawable.pScreen;
+    miBSWindowPtr   pBackingStore = (miBSWindowPtr) pWin->backStorage;
+    miBSWindowPtr   pVictim, pPrev;
+    unsigned long   bytes, limit;
+
+    if (backingStoreLimit)
+    {
+	limit = backingStoreLimit * 1024;
+	bytes = (unsigned long) PixmapBytePad(w, pWin->drawable.depth) * h;
+	for (pVictim = miBSLRUTail;
+	     pVictim && miBSPixmapBytes + bytes > limit;
+	     pVictim = pPrev)
+	{
+	    pPrev = pVictim->lruPrev;
+	    if (pVictim == pBackingStore)
+		continue;
+	    REGION_EMPTY(pVictim->pWin->drawable.pScreen,
+			 &pVictim->SavedRegion);
+	    miDestroyBSPixmap (pVictim->pWin);
+	}
+	if (miBSPixmapBytes + bytes > limit)
+	    return NullPixmap;
+    }
+    return (PixmapPtr)(*pScreen->CreatePixmap) (pScreen, w, h,
+						pWin->drawable.depth);
+}
+
+/*
+ * Replace the backing pixmap of pWin, keeping the accounting straight
+ */
+static void
+miBSSetPixmap (pWin, pPixmap)
+    WindowPtr	pWin;
+    PixmapPtr	pPixmap;
+{
+    miBSWindowPtr   pBackingStore = (miBSWindowPtr) pWin->backStorage;
+
+    if (pBackingStore->pBackingPixmap)
+    {
+	miBSPixmapBytes -= pBackingStore->pixmapBytes;
+	miBSUnlink (pBackingStore);
+	pBackingStore->pixmapBytes = 0;
+	(* pWin->drawable.pScreen->DestroyPixmap)(pBackingStore->pBackingPixmap);
+    }
+    pBackingStore->pBackingPixmap = pPixmap;
+    if (pPixmap)
+    {
+	pBackingStore->pixmapBytes = (unsigned long)
+	    PixmapBytePad(pPixmap->drawable.width, pPixmap->drawable.depth) *
+	    pPixmap->drawable.height;
+	miBSPixmapBytes += pBackingStore->pixmapBytes;
+	miBSLink (pBackingStore);
+    }
+}
+
 static void
 miDestroyBSPixmap (pWin)
     WindowPtr	pWin;
@@ -3665,9 +3823,7 @@ miDestroyBSPixmap (pWin)
     
     pScreen = pWin->drawable.pScreen;
     pBackingStore = (miBSWindowPtr) pWin->backStorage;
-    if (pBackingStore->pBackingPixmap)
-	(* pScreen->DestroyPixmap)(pBackingStore->pBackingPixmap);
-    pBackingStore->pBackingPixmap = NullPixmap;
+    miBSSetPixmap (pWin, NullPixmap);
     pBackingStore->x = 0;
     pBackingStore->y = 0;
     if (pBackingStore->backgroundState == BackgroundPixmap)
@@ -3734,15 +3890,14 @@ miCreateBSPixmap (pWin, pExtents)
 	extents->x2 != extents->x1 &&
 	extents->y2 != extents->y1)
     {
-	/* the policy here could be more sophisticated */
-	pBackingStore->x = extents->x1;
-	pBackingStore->y = extents->y1;
-	pBackingStore->pBackingPixmap =
-    	    (PixmapPtr)(* pScreen->CreatePixmap)
-			   (pScreen,
-			    extents->x2 - extents->x1,
-			    extents->y2 - extents->y1,
-			    pWin->drawable.depth);
+	BoxRec	box;
+
+	/* cover the whole window so later saves needn't grow it */
+	miBSPixmapBox (pWin, &box);
+	pBackingStore->x = box.x1;
+	pBackingStore->y = box.y1;
+	miBSSetPixmap (pWin, miBSCreatePixmap (pWin, box.x2 - box.x1,
+					       box.y2 - box.y1));
     }
     if (!pBackingStore->pBackingPixmap)
     {
@@ -57,7 +57,7 @@ typedef struct {
  * one of these structures is allocated per Window with backing store
  */
 
-typedef struct {
+typedef struct _miBSWindow {
     PixmapPtr	  pBackingPixmap;   /* Pixmap for saved areas */
     short	  x;		    /* origin of pixmap relative to window */
     short	  y;
@@ -68,6 +68,10 @@ typedef struct {
     char    	  status;    	    /* StatusNoPixmap, etc. */
     char	  backgroundState;  /* background type */
     PixUnion	  background;	    /* background pattern */
+    WindowPtr	  pWin;		    /* owning window */
+    unsigned long pixmapBytes;	    /* size of pBackingPixmap */
+    struct _miBSWindow *lruPrev;    /* windows holding pixmaps, */
+    struct _miBSWindow *lruNext;    /* most recently used first */
 } miBSWindowRec, *miBSWindowPtr;
 
 #define StatusNoPixmap	1	/* pixmap has not been created */
@@ -384,6 +384,10 @@ miSpriteInitialize (pScreen, cursorFuncs, screenFuncs)
     pPriv->pCacheWin = NullWindow;
     pPriv->isInCacheWin = FALSE;
     pPriv->checkPixels = TRUE;
+    pPriv->readout = FALSE;
+    pPriv->readoutMoved = FALSE;
+    pPriv->readoutShown.x1 = pPriv->readoutShown.x2 = 0;
+    pPriv->readoutShown.y1 = pPriv->readoutShown.y2 = 0;
     pPriv->pInstalledMap = NULL;
     pPriv->pColormap = NULL;
     pPriv->funcs = cursorFuncs;
@@ -421,6 +425,93 @@ miSpriteInitialize (pScreen, cursorFuncs, screenFuncs)
     return TRUE;
 }
 
+/*
+ * Readout mode -- the cursor is never left in the frame buffer, so
+ * rendering never has to remove and restore it.  Whatever reads the
+ * frame buffer out (the shadow update, say) brackets the read with
+ * miSpriteReadoutBegin and miSpriteReadoutEnd to see the cursor.
+ * Select this at screen initialization, before any GC is validated.
+ */
+
+void
+miSpriteSetReadout (pScreen, readout)
+    ScreenPtr	pScreen;
+    Bool	readout;
+{
+    miSpriteScreenPtr	pScreenPriv;
+
+    pScreenPriv = (miSpriteScreenPtr) pScreen->devPrivates[miSpriteScreenIndex].ptr;
+    if (pScreenPriv->isUp)
+	miSpriteRemoveCursor (pScreen);
+    pScreenPriv->readout = readout;
+    pScreenPriv->readoutMoved = TRUE;
+}
+
+/*
+ * Returns FALSE unless pScreen uses readout mode; otherwise pChanged is
+ * set to the area the cursor has left or entered since the last call,
+ * which is empty when it hasn't changed
+ */
+
+Bool
+miSpriteReadout (pScreen, pChanged)
+    ScreenPtr	pScreen;
+    BoxPtr	pChanged;
+{
+    miSpriteScreenPtr	pScreenPriv;
+    BoxPtr		pShown;
+
+    if (miSpriteGeneration != serverGeneration)
+	return FALSE;
+    pScreenPriv = (miSpriteScreenPtr) pScreen->devPrivates[miSpriteScreenIndex].ptr;
+    if (!pScreenPriv || !pScreenPriv->readout)
+	return FALSE;
+    pShown = &pScreenPriv->readoutShown;
+    pChanged->x1 = pChanged->x2 = pChanged->y1 = pChanged->y2 = 0;
+    if (!pScreenPriv->readoutMoved)
+	return TRUE;
+    pScreenPriv->readoutMoved = FALSE;
+    *pChanged = *pShown;
+    pShown->x1 = pShown->x2 = pShown->y1 = pShown->y2 = 0;
+    if (pScreenPriv->shouldBeUp && pScreenPriv->pCursor)
+    {
+	miSpriteComputeSaved (pScreen);
+	*pShown = pScreenPriv->saved;
+	if (pChanged->x1 >= pChanged->x2 || pChanged->y1 >= pChanged->y2)
+	    *pChanged = *pShown;
+	else
+	{
+	    if (pShown->x1 < pChanged->x1) pChanged->x1 = pShown->x1;
+	    if (pShown->y1 < pChanged->y1) pChanged->y1 = pShown->y1;
+	    if (pShown->x2 > pChanged->x2) pChanged->x2 = pShown->x2;
+	    if (pShown->y2 > pChanged->y2) pChanged->y2 = pShown->y2;
+	}
+    }
+    return TRUE;
+}
+
+void
+miSpriteReadoutBegin (pScreen)
+    ScreenPtr	pScreen;
+{
+    miSpriteScreenPtr	pScreenPriv;
+
+    pScreenPriv = (miSpriteScreenPtr) pScreen->devPrivates[miSpriteScreenIndex].ptr;
+    if (!pScreenPriv->isUp && pScreenPriv->shouldBeUp && pScreenPriv->pCursor)
+	miSpriteRestoreCursor (pScreen);
+}
+
+void
+miSpriteReadoutEnd (pScreen)
+    ScreenPtr	pScreen;
+{
+    miSpriteScreenPtr	pScreenPriv;
+
+    pScreenPriv = (miSpriteScreenPtr) pScreen->devPrivates[miSpriteScreenIndex].ptr;
+    if (pScreenPriv->isUp)
+	miSpriteRemoveCursor (pScreen);
+}
+
 /*
  * Screen wrappers
  */
@@ -609,7 +700,7 @@ miSpriteBlockHandler (i, blockData, pTimeout, pReadmask)
 
     SCREEN_EPILOGUE(pScreen, BlockHandler, miSpriteBlockHandler);
 
-    if (!pPriv->isUp && pPriv->shouldBeUp)
+    if (!pPriv->isUp && pPriv->shouldBeUp && !pPriv->readout)
 	miSpriteRestoreCursor (pScreen);
 }
 
@@ -960,12 +1051,15 @@ miSpriteValidateGC (pGC, changes, pDrawable)
     unsigned long	changes;
     DrawablePtr	pDrawable;
 {
+    GC_SETUP_CHEAP (pDrawable)
     GC_FUNC_PROLOGUE (pGC);
 
     (*pGC->funcs->ValidateGC) (pGC, changes, pDrawable);
     
     pGCPriv->wrapOps = NULL;
-    if (pDrawable->type == DRAWABLE_WINDOW && ((WindowPtr) pDrawable)->viewable)
+    /* in readout mode rendering never meets the cursor */
+    if (pDrawable->type == DRAWABLE_WINDOW &&
+	((WindowPtr) pDrawable)->viewable && !pScreenPriv->readout)
     {
 	WindowPtr   pWin;
 	RegionPtr   pRegion;
@@ -2145,6 +2239,7 @@ miSpriteSetCursor (pScreen, pCursor, x, y)
     pScreenPriv = (miSpriteScreenPtr) pScreen->devPrivates[miSpriteScreenIndex].ptr;
     if (!pCursor)
     {
+	pScreenPriv->readoutMoved = TRUE;
     	pScreenPriv->shouldBeUp = FALSE;
     	if (pScreenPriv->isUp)
 	    miSpriteRemoveCursor (pScreen);
@@ -2167,6 +2262,11 @@ miSpriteSetCursor (pScreen, pCursor, x, y)
 	pScreenPriv->pCursor = pCursor;
 	miSpriteFindColors (pScreen);
     }
+    if (pScreenPriv->readout)
+    {
+	pScreenPriv->readoutMoved = TRUE;
+	return;
+    }
     if (pScreenPriv->isUp) {
 	int	sx, sy;
 	/*
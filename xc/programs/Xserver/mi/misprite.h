@@ -94,3 +94,21 @@ extern Bool miSpriteInitialize(
     miSpriteCursorFuncPtr /*cursorFuncs*/,
     miPointerScreenFuncPtr /*screenFuncs*/
 );
+
+extern void miSpriteSetReadout(
+    ScreenPtr /*pScreen*/,
+    Bool /*readout*/
+);
+
+extern Bool miSpriteReadout(
+    ScreenPtr /*pScreen*/,
+    BoxPtr /*pChanged*/
+);
+
+extern void miSpriteReadoutBegin(
+    ScreenPtr /*pScreen*/
+);
+
+extern void miSpriteReadoutEnd(
+    ScreenPtr /*pScreen*/
+);
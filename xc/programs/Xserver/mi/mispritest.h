@@ -70,6 +70,9 @@ typedef struct {
     WindowPtr	    pCacheWin;
     Bool	    isInCacheWin;
     Bool	    checkPixels;
+    Bool	    readout;		/* cursor drawn only for readout */
+    Bool	    readoutMoved;
+    BoxRec	    readoutShown;
     xColorItem	    colors[2];
     ColormapPtr	    pInstalledMap;
     ColormapPtr	    pColormap;
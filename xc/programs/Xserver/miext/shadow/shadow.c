@@ -33,6 +33,8 @@
 #include    "regionstr.h"
 #include    "globals.h"
 #include    "gcstruct.h"
+#include    "mipointer.h"
+#include    "misprite.h"
 #include    "shadow.h"
 
 typedef struct _shadowGCPriv {
@@ -58,12 +60,36 @@ int shadowGeneration;
     real->mem = priv->mem; \
 }
 
+/*
+ * A software cursor in readout mode lives in the shadow only while
+ * the update runs; its own drawing lands in the damage, and where it
+ * used to be is added explicitly
+ */
 static void
 shadowRedisplay (ScreenPtr pScreen)
 {
     shadowScrPriv(pScreen);
     shadowBufPtr    pBuf;
+    BoxRec	    box;
+    RegionRec	    region;
+    Bool	    readout, pending = FALSE;
 
+    readout = miSpriteReadout (pScreen, &box);
+    for (pBuf = pScrPriv->pBuf; pBuf; pBuf = pBuf->pNext)
+    {
+	if (readout && box.x1 < box.x2 && box.y1 < box.y2)
+	{
+	    REGION_INIT (pScreen, &region, &box, 1);
+	    REGION_UNION (pScreen, &pBuf->damage, &pBuf->damage, &region);
+	    REGION_UNINIT (pScreen, &region);
+	}
+	if (REGION_NOTEMPTY (pScreen, &pBuf->damage))
+	    pending = TRUE;
+    }
+    if (!pending)
+	return;
+    if (readout)
+	miSpriteReadoutBegin (pScreen);
     for (pBuf = pScrPriv->pBuf; pBuf; pBuf = pBuf->pNext)
     {
 	if (REGION_NOTEMPTY (pScreen, &pBuf->damage))
@@ -71,9 +97,12 @@ shadowRedisplay (ScreenPtr pScreen)
 	    REGION_INTERSECT (pScreen, &pBuf->damage, &pBuf->damage,
 			      &WindowTable[pScreen->myNum]->borderClip);
 	    (*pBuf->update) (pScreen, pBuf);
-	    REGION_EMPTY (pScreen, &pBuf->damage);
 	}
     }
+    if (readout)
+	miSpriteReadoutEnd (pScreen);
+    for (pBuf = pScrPriv->pBuf; pBuf; pBuf = pBuf->pNext)
+	REGION_EMPTY (pScreen, &pBuf->damage);
 }
 
 static void
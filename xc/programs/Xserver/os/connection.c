@@ -184,6 +184,7 @@ Bool AnyClientsWriteBlocked;	/* true if some client blocked on write */
 Bool RunFromSmartParent;	/* send SIGUSR1 to parent process */
 Bool PartialNetwork;		/* continue even if unable to bind all addrs */
 char *protNoListen;             /* don't listen on this protocol */
+int ListenBacklog;		/* listen() backlog, 0 for the default */
 static Pid_t ParentProcess;
 
 static Bool debug_conns = FALSE;
@@ -216,6 +217,12 @@ XtransConnInfo /* trans_conn */
 #endif
 );
 
+static void ResetOsCommPool(
+#if NeedFunctionPrototypes
+void
+#endif
+);
+
 #ifndef LBX
 static
 #endif
@@ -338,6 +345,8 @@ CreateWellKnownSockets()
         {
 	    FatalError ("Failed to disable listen for %s", protNoListen);
 	}
+    if (ListenBacklog > 0)
+	_XSERVTransSetListenBacklog (ListenBacklog);
     
     if ((_XSERVTransMakeAllCOTSServerListeners (port, &partial,
 	&ListenTransCount, &ListenTransConns) >= 0) &&
@@ -412,6 +421,7 @@ ResetWellKnownSockets ()
     int i;
 
     ResetOsBuffers();
+    ResetOsCommPool();
 
     for (i = 0; i < ListenTransCount; i++)
     {
@@ -727,6 +737,40 @@ ClientAuthorized(client, proto_n, auth_proto, string_n, auth_string)
     return((char *)NULL);
 }
 
+/*
+ * OsCommRecs of departed clients are kept for the next connections, so
+ * that a crowd of clients connecting at once mostly reuses them.
+ */
+#define OS_COMM_POOL_SIZE   32
+
+static OsCommPtr osCommPool[OS_COMM_POOL_SIZE];
+static int osCommPoolCount;
+
+static OsCommPtr
+AllocOsComm ()
+{
+    if (osCommPoolCount)
+	return osCommPool[--osCommPoolCount];
+    return (OsCommPtr)xalloc(sizeof(OsCommRec));
+}
+
+static void
+FreeOsComm (oc)
+    OsCommPtr oc;
+{
+    if (osCommPoolCount < OS_COMM_POOL_SIZE)
+	osCommPool[osCommPoolCount++] = oc;
+    else
+	xfree(oc);
+}
+
+static void
+ResetOsCommPool ()
+{
+    while (osCommPoolCount)
+	xfree(osCommPool[--osCommPoolCount]);
+}
+
 static ClientPtr
 #ifdef LBX
 AllocNewConnection (trans_conn, fd, conn_time, Flush, Close, proxy)
@@ -756,12 +800,13 @@ AllocNewConnection (trans_conn, fd, conn_time)
 #endif
 	)
 	return NullClient;
-    oc = (OsCommPtr)xalloc(sizeof(OsCommRec));
+    oc = AllocOsComm();
     if (!oc)
 	return NullClient;
     oc->trans_conn = trans_conn;
     oc->fd = fd;
     oc->input = (ConnectionInputPtr)NULL;
+    oc->large = (ConnectionInputPtr)NULL;
     oc->output = (ConnectionOutputPtr)NULL;
     oc->auth_id = None;
     oc->conn_time = conn_time;
@@ -773,7 +818,7 @@ AllocNewConnection (trans_conn, fd, conn_time)
 #endif
     if (!(client = NextAvailableClient((pointer)oc)))
     {
-	xfree (oc);
+	FreeOsComm (oc);
 	return NullClient;
     }
 #ifdef LBX
@@ -839,6 +884,28 @@ LbxProxyConnection (client, proxy)
 
 #endif
 
+/*
+ * A listener may have many connections queued when lots of clients start
+ * at once; take up to MAX_ACCEPTS_PER_LISTENER of them each time through
+ * rather than one, but no more, so the established clients still get
+ * served in between.
+ */
+#define MAX_ACCEPTS_PER_LISTENER    16
+
+static Bool
+ListenerReady (fd)
+    int fd;
+{
+    fd_set mask;
+    struct timeval poll;
+
+    poll.tv_sec = 0;
+    poll.tv_usec = 0;
+    FD_ZERO(&mask);
+    FD_SET(fd, &mask);
+    return Select(fd + 1, &mask, NULL, NULL, &poll) > 0;
+}
+
 /*****************
  * EstablishNewConnections
  *    If anyone is waiting on listened sockets, accept them.
@@ -860,6 +927,7 @@ EstablishNewConnections(clientUnused, closure)
     register ClientPtr client;
     register OsCommPtr oc;
     fd_set tmask;
+    int accepted;
 
     XFD_ANDSET (&tmask, (fd_set*)closure, &WellKnownConnections);
     XFD_COPYSET(&tmask, &readyconnections);
@@ -900,30 +968,36 @@ EstablishNewConnections(clientUnused, closure)
 	if ((trans_conn = lookup_trans_conn (curconn)) == NULL)
 	    continue;
 
-	if ((new_trans_conn = _XSERVTransAccept (trans_conn, &status)) == NULL)
-	    continue;
+	for (accepted = 0; accepted < MAX_ACCEPTS_PER_LISTENER; accepted++)
+	{
+	    if (accepted && !ListenerReady (curconn))
+		break;
 
-	newconn = _XSERVTransGetConnectionNumber (new_trans_conn);
+	    if ((new_trans_conn = _XSERVTransAccept (trans_conn, &status)) == NULL)
+		break;
 
-	if (newconn < lastfdesc)
-	{
+	    newconn = _XSERVTransGetConnectionNumber (new_trans_conn);
+
+	    if (newconn < lastfdesc)
+	    {
 		int clientid;
-  		clientid = ConnectionTranslation[newconn];
+		clientid = ConnectionTranslation[newconn];
 		if(clientid && (client = clients[clientid]))
- 			CloseDownClient(client);
-	}
+		    CloseDownClient(client);
+	    }
 
-	_XSERVTransSetOption(new_trans_conn, TRANS_NONBLOCKING, 1);
+	    _XSERVTransSetOption(new_trans_conn, TRANS_NONBLOCKING, 1);
 
-	if (!AllocNewConnection (new_trans_conn, newconn, connect_time
+	    if (!AllocNewConnection (new_trans_conn, newconn, connect_time
 #ifdef LBX
-				 , StandardFlushClient,
-				 CloseDownFileDescriptor, (LbxProxyPtr)NULL
+				     , StandardFlushClient,
+				     CloseDownFileDescriptor, (LbxProxyPtr)NULL
 #endif
-				))
-	{
-	    ErrorConnMax(new_trans_conn);
-	    _XSERVTransClose(new_trans_conn);
+				    ))
+	    {
+		ErrorConnMax(new_trans_conn);
+		_XSERVTransClose(new_trans_conn);
+	    }
 	}
       }
 #ifndef WIN32
@@ -1011,7 +1085,7 @@ CloseDownFileDescriptor(oc)
     }
 #ifndef LBX
     FreeOsBuffers(oc);
-    xfree(oc);
+    FreeOsComm(oc);
 #endif
     ConnectionTranslation[connection] = 0;
     FD_CLR(connection, &AllSockets);
@@ -1109,7 +1183,7 @@ CloseDownConnection(client)
 #else
     (*oc->Close) (client);
     FreeOsBuffers(oc);
-    xfree(oc);
+    FreeOsComm(oc);
 #endif
     client->osPrivate = (pointer)NULL;
     if (auditTrailLevel > 1)
@@ -126,6 +126,17 @@ OsCommPtr AvailableInput = (OsCommPtr)NULL;
 
 #define MAX_TIMES_PER         10
 
+/*
+ * Without the smart scheduler, a client whose buffer holds complete
+ * requests is not made to yield after every MAX_TIMES_PER of them;
+ * instead the clock is checked that often and the client keeps the
+ * server until it has run for BATCH_SLICE milliseconds.  Running out
+ * of complete requests still yields at once, and output is flushed
+ * once at the end of the turn.
+ */
+#define BATCH_SLICE           20
+static CARD32 batchStart;
+
 /*
  *   A lot of the code in this file manipulates a ConnectionInputPtr:
  *
@@ -192,6 +203,90 @@ OsCommPtr AvailableInput = (OsCommPtr)NULL;
 #define YieldControlDeath()			\
         { timesThisConnection = 0; }
 
+/*
+ * Requests bigger than BUFSIZE (mostly image data) are not assembled in
+ * the shared input buffer, which would have to grow to fit them and be
+ * compacted around them.  Once the length is known, the part already
+ * read moves to a ConnectionInput of exactly that size, oc->large, and
+ * the rest is read straight into it; nothing beyond the request is read
+ * there, so the regular buffer carries on with the following requests.
+ * oc->large->lenLastReq is set while the request is being executed, and
+ * the buffer is freed when the next request is read.
+ */
+
+static void
+FreeLargeRequest(oc)
+    OsCommPtr oc;
+{
+    xfree(oc->large->buffer);
+    xfree(oc->large);
+    oc->large = (ConnectionInputPtr)NULL;
+}
+
+static int
+ReadLargeRequest(client, oc)
+    ClientPtr client;
+    OsCommPtr oc;
+{
+    register ConnectionInputPtr lci = oc->large;
+    int fd = oc->fd;
+    int result;
+    xReq *request;
+
+    if (lci->bufcnt < lci->size)
+    {
+	if (!oc->trans_conn)
+	{
+	    YieldControlDeath();
+	    return -1;
+	}
+	result = _XSERVTransRead(oc->trans_conn, lci->buffer + lci->bufcnt,
+				 lci->size - lci->bufcnt);
+	if (result <= 0)
+	{
+	    if ((result < 0) && ETEST(errno))
+	    {
+		YieldControlNoInput();
+		return 0;
+	    }
+	    YieldControlDeath();
+	    return -1;
+	}
+	lci->bufcnt += result;
+	if (lci->bufcnt < lci->size)
+	{
+	    YieldControlNoInput();
+	    return 0;
+	}
+    }
+    lci->bufptr = lci->buffer;
+    lci->lenLastReq = lci->size;
+    client->req_len = lci->size >> 2;
+
+    /* nothing was read past the request, so the regular buffer is empty */
+    if (oc->input)
+	AvailableInput = oc;
+#ifdef SMART_SCHEDULE
+    if (!SmartScheduleDisable)
+	FD_CLR(fd, &ClientsWithInput);
+    else
+#endif
+	YieldControlNoInput();
+
+#ifdef BIGREQS
+    request = (xReq *)lci->bufptr;
+    if (!get_req_len(request, client))
+    {
+	lci->bufptr += (sizeof(xBigReq) - sizeof(xReq));
+	*(xReq *)lci->bufptr = *request;
+	lci->lenLastReq -= (sizeof(xBigReq) - sizeof(xReq));
+	client->req_len -= (sizeof(xBigReq) - sizeof(xReq)) >> 2;
+    }
+#endif
+    client->requestBuffer = (pointer)lci->bufptr;
+    return lci->size;
+}
+
 #ifdef hpux_not_tog
 #define LBX_NEED_OLD_SYMBOL_FOR_LOADABLES
 #endif
@@ -226,6 +321,13 @@ ReadRequestFromClient(client)
     Bool move_header;
 #endif
 
+    if (oc->large)
+    {
+	if (!oc->large->lenLastReq)
+	    return ReadLargeRequest(client, oc);
+	FreeLargeRequest(oc);
+    }
+
     /* If an input buffer was empty, either free it if it is too big
      * or link it into our list of free input buffers.  This means that
      * different clients can share the same input buffer (at different
@@ -325,6 +427,31 @@ ReadRequestFromClient(client)
 	    YieldControlDeath();
 	    return -1;
 	}
+	if (!need_header && needed > BUFSIZE
+#ifdef LBX
+	    && !oc->proxy
+#endif
+	    )
+	{
+	    register ConnectionInputPtr lci;
+
+	    lci = (ConnectionInputPtr)xalloc(sizeof(ConnectionInput));
+	    if (!lci || !(lci->buffer = (char *)xalloc(needed)))
+	    {
+		xfree(lci);
+		YieldControlDeath();
+		return -1;
+	    }
+	    memmove(lci->buffer, oci->bufptr, gotnow);
+	    lci->bufptr = lci->buffer;
+	    lci->bufcnt = gotnow;
+	    lci->size = needed;
+	    lci->lenLastReq = 0;
+	    oc->large = lci;
+	    oci->bufptr = oci->buffer;
+	    oci->bufcnt = 0;
+	    return ReadLargeRequest(client, oc);
+	}
 	if ((gotnow == 0) ||
 	    ((oci->bufptr - oci->buffer + needed) > oci->size))
 	{
@@ -494,8 +621,13 @@ ReadRequestFromClient(client)
 #ifdef SMART_SCHEDULE
     if (SmartScheduleDisable)
 #endif
-    if (++timesThisConnection >= MAX_TIMES_PER)
-	YieldControl();
+    {
+	if (++timesThisConnection == 1)
+	    batchStart = GetTimeInMillis();
+	else if ((timesThisConnection % MAX_TIMES_PER) == 0 &&
+		 (GetTimeInMillis() - batchStart) >= BATCH_SLICE)
+	    YieldControl();
+    }
 #ifdef BIGREQS
     if (move_header)
     {
@@ -607,6 +739,7 @@ ResetCurrentRequest(client)
     OsCommPtr oc = (OsCommPtr)client->osPrivate;
     register ConnectionInputPtr oci = oc->input;
     int fd = oc->fd;
+    register ConnectionInputPtr lci = oc->large;
     register xReq *request;
     int gotnow, needed;
 #ifdef LBX
@@ -621,6 +754,29 @@ ResetCurrentRequest(client)
 	}
     }
 #endif
+    if (lci && lci->lenLastReq)
+    {
+	/* the current request is the one in the large buffer */
+	lci->lenLastReq = 0;
+#ifdef BIGREQS
+	if (lci->bufptr != lci->buffer)
+	{
+	    lci->bufptr = lci->buffer;
+	    ((xBigReq *)lci->bufptr)->length = lci->size >> 2;
+	    if (client->swapped)
+	    {
+		char n;
+		swapl(&((xBigReq *)lci->bufptr)->length, n);
+	    }
+	}
+#endif
+	if (FD_ISSET(fd, &AllClients))
+	    FD_SET(fd, &ClientsWithInput);
+	else
+	    FD_SET(fd, &IgnoredClientsWithInput);
+	YieldControl();
+	return;
+    }
     if (AvailableInput == oc)
 	AvailableInput = (OsCommPtr)NULL;
     oci->lenLastReq = 0;
@@ -691,12 +847,20 @@ PeekNextRequest(req, client, readmore)
     Bool readmore;	/* attempt to read more if next request isn't there? */
 {
     register ConnectionInputPtr oci = ((OsCommPtr)client->osPrivate)->input;
+    register ConnectionInputPtr lci = ((OsCommPtr)client->osPrivate)->large;
     xReqPtr pnextreq;
     int needed, gotnow, reqlen;
 
     if (!oci) return NULL;
 
-    if (!req)
+    if (lci && lci->lenLastReq &&
+	(!req || ((char *)req >= lci->buffer &&
+		  (char *)req < lci->buffer + lci->size)))
+    {
+	/* the current request is in the large buffer; the rest follow */
+	pnextreq = (xReqPtr)(oci->bufptr + oci->lenLastReq);
+    }
+    else if (!req)
     {
 	/* caller wants the request after the one currently being executed */
 	pnextreq = (xReqPtr)
@@ -902,6 +1066,24 @@ SetCriticalOutputPending()
     CriticalOutputPending = TRUE;
 }
 
+/*****************
+ * ClientIsWriteBlocked
+ *    Returns TRUE if the last attempt to write to the client would have
+ *    blocked, so further output is only being queued in the server.
+ *    Producers of bulk data can use this to apply backpressure.
+ *****************/
+
+Bool
+ClientIsWriteBlocked(who)
+    ClientPtr who;
+{
+    OsCommPtr oc = (OsCommPtr)who->osPrivate;
+
+    if (!AnyClientsWriteBlocked || !oc || oc->fd < 0)
+	return FALSE;
+    return FD_ISSET(oc->fd, &ClientsWriteBlocked) != 0;
+}
+
 /*****************
  * WriteToClient
  *    Copies buf into ClientPtr.buf if it fits (with padding), else
@@ -1334,6 +1516,8 @@ FreeOsBuffers(oc)
 	xfree(oci);
     }
 #endif
+    if (oc->large)
+	FreeLargeRequest(oc);
 }
 
 void
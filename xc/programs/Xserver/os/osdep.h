@@ -191,6 +191,7 @@ typedef int (*OsFlushFunc)(ClientPtr who, struct _osComm * oc, char* extraBuf, i
 typedef struct _osComm {
     int fd;
     ConnectionInputPtr input;
+    ConnectionInputPtr large;	/* holds one request bigger than BUFSIZE */
     ConnectionOutputPtr output;
     XID	auth_id;		/* authorization id */
 #ifdef K5AUTH
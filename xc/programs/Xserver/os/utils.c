@@ -135,6 +135,10 @@ Bool PanoramiXWindowExposureSent = FALSE;
 Bool PanoramiXOneExposeRequest = FALSE;
 #endif
 
+#ifdef XRECORD
+int RecordRingSize = 0;
+#endif
+
 #ifdef DDXOSVERRORF
 void (*OsVendorVErrorFProc)(const char *, va_list args) = NULL;
 #endif
@@ -495,10 +499,12 @@ void UseMsg()
 #endif
     ErrorF("-audit int             set audit trail level\n");	
     ErrorF("-auth file             select authorization file\n");	
+    ErrorF("-backlog int           listen queue length for connections\n");
     ErrorF("bc                     enable bug compatibility\n");
     ErrorF("-br                    create root window with black background\n");
     ErrorF("+bs                    enable any backing store support\n");
     ErrorF("-bs                    disable any backing store support\n");
+    ErrorF("-bslimit int           limit backing store pixmaps to int kilobytes\n");
     ErrorF("-c                     turns off key-click\n");
     ErrorF("c #                    key-click volume (0-100)\n");
     ErrorF("-cc int                default color visual class\n");
@@ -539,6 +545,9 @@ void UseMsg()
     ErrorF("-p #                   screen-saver pattern duration (minutes)\n");
     ErrorF("-pn                    accept failure to listen on all ports\n");
     ErrorF("-nopn                  reject failure to listen on all ports\n");
+#ifdef XRECORD
+    ErrorF("-recordring int        RECORD capture ring size in Kb\n");
+#endif
     ErrorF("-r                     turns off auto-repeat\n");
     ErrorF("r                      turns on auto-repeat \n");
 #ifdef RENDER
@@ -661,6 +670,13 @@ char	*argv[];
 	    else
 		UseMsg();
 	}
+	else if ( strcmp( argv[i], "-backlog") == 0)
+	{
+	    if(++i < argc)
+	        ListenBacklog = atoi(argv[i]);
+	    else
+		UseMsg();
+	}
 	else if ( strcmp( argv[i], "bc") == 0)
 	    permitOldBugs = TRUE;
 	else if ( strcmp( argv[i], "-br") == 0)
@@ -669,6 +685,13 @@ char	*argv[];
 	    enableBackingStore = TRUE;
 	else if ( strcmp( argv[i], "-bs") == 0)
 	    disableBackingStore = TRUE;
+	else if ( strcmp( argv[i], "-bslimit") == 0)
+	{
+	    if(++i < argc)
+	        backingStoreLimit = atol(argv[i]);
+	    else
+		UseMsg();
+	}
 	else if ( strcmp( argv[i], "c") == 0)
 	{
 	    if(++i < argc)
@@ -874,6 +897,15 @@ char	*argv[];
 	    else
 		UseMsg();
 	}
+#ifdef XRECORD
+	else if ( strcmp( argv[i], "-recordring") == 0)
+	{
+	    if(++i < argc)
+		RecordRingSize = atoi(argv[i]) * 1024;
+	    else
+		UseMsg();
+	}
+#endif
 	else if ( strcmp( argv[i], "-tst") == 0)
 	{
 	    noTestExtensions = TRUE;
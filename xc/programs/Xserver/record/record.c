@@ -44,6 +44,14 @@ and Jim Haggerty of Metheus.
 #ifndef XFree86LOADER
 #include <stdio.h>
 #include <assert.h>
+#ifdef HAS_MMAP
+#include <sys/types.h>
+#include <sys/mman.h>
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#define RECORD_RING_MMAP
+#endif
 #else
 #include "xf86_ansic.h"
 #endif
@@ -63,6 +71,16 @@ static int RecordErrorBase; /* first Record error number */
  */
 #define REPLY_BUF_SIZE 1024
 
+/* Size in bytes of the capture ring of each enabled context, set with the
+ * -recordring command line option (os/utils.c).  When zero, recorded
+ * protocol is written to the recording client as it is generated.
+ * Otherwise it is appended to the ring, which is drained to the recording
+ * client from a block handler once per scheduling round, and protocol
+ * elements that do not fit while the recording client is not reading are
+ * dropped and counted instead of being queued without bound.
+ */
+extern int RecordRingSize;
+
 /* Record Context structure */
 
 typedef struct {
@@ -75,6 +93,13 @@ typedef struct {
     char	bufCategory;	   /* category of protocol in replyBuffer */
     int		numBufBytes;	   /* number of bytes in replyBuffer */
     char	replyBuffer[REPLY_BUF_SIZE]; /* buffered recorded protocol */
+    char	*pRing;		   /* capture ring, or NULL if not in use */
+    int		ringSize;	   /* size of pRing in bytes */
+    int		ringHead;	   /* offset of oldest undrained byte */
+    int		ringUsed;	   /* number of undrained bytes in pRing */
+    int		ringReserved;	   /* bytes owed to accepted elements */
+    unsigned int droppingElement:1; /* discarding a dropped element? */
+    unsigned long numDropped;	   /* elements dropped because ring full */
 } RecordContextRec, *RecordContextPtr;
 
 /*  RecordMinorOpRec - to hold minor opcode selections for extension requests
@@ -108,6 +133,11 @@ typedef struct _RecordClientsAndProtocolRec {
     RecordSetPtr     pDeviceEventSet;    /* device events to record */
     RecordSetPtr     pDeliveredEventSet; /* delivered events to record */
     RecordSetPtr     pErrorSet;          /* errors to record */
+    RecordOpcodeMask requestMajorOpMask; /* pRequestMajorOpSet as bitmap */
+    RecordOpcodeMask replyMajorOpMask;   /* pReplyMajorOpSet as bitmap */
+    RecordOpcodeMask deviceEventMask;    /* pDeviceEventSet as bitmap */
+    RecordOpcodeMask deliveredEventMask; /* pDeliveredEventSet as bitmap */
+    RecordOpcodeMask errorMask;          /* pErrorSet as bitmap */
     XID *	     pClientIDs;	 /* array of clients to record */
     short 	     numClients;	 /* number of clients in pClientIDs */
     short	     sizeClients;	 /* size of pClientIDs array */
@@ -122,6 +152,9 @@ typedef struct _RecordClientsAndProtocolRec {
 /* counts the total number of RCAPs belonging to enabled contexts. */
 static int numEnabledRCAPs;
 
+/* counts the enabled contexts that have a capture ring. */
+static int numRingContexts;
+
 /*  void VERIFY_CONTEXT(RecordContextPtr, XID, ClientPtr)
  *  In the spirit of the VERIFY_* macros in dix.h, this macro fills in
  *  the context pointer if the given ID is a valid Record Context, else it
@@ -222,6 +255,99 @@ RecordFindContextOnAllContexts(pContext)
 
 /***************************************************************************/
 
+/* RecordRingWrite
+ *
+ * Arguments:
+ *	pContext is a context with a capture ring.
+ *	data is a pointer to recorded protocol, and len is its length in
+ *	  bytes.  The space must have been reserved by RecordRingReserve.
+ *
+ * Returns: nothing.
+ *
+ * Side Effects:
+ *	The data is appended to the ring and its reservation released.
+ */
+static void
+RecordRingWrite(pContext, data, len)
+    RecordContextPtr pContext;
+    pointer data;
+    int len;
+{
+    int tail, n;
+
+    assert(len <= pContext->ringReserved);
+    pContext->ringReserved -= len;
+    tail = (pContext->ringHead + pContext->ringUsed) % pContext->ringSize;
+    n = pContext->ringSize - tail;
+    if (n > len)
+	n = len;
+    memcpy(pContext->pRing + tail, data, n);
+    if (len > n)
+	memcpy(pContext->pRing, (char *)data + n, len - n);
+    pContext->ringUsed += len;
+} /* RecordRingWrite */
+
+
+/* RecordRingReserve
+ *
+ * Arguments:
+ *	pContext is a context with a capture ring.
+ *	len is the number of bytes a new protocol element will need,
+ *	  including all data that will follow as continuations.
+ *
+ * Returns: TRUE if the space was reserved, FALSE if the element must
+ *	be dropped.
+ *
+ * Side Effects:
+ *	Space is reserved in the ring, or numDropped is incremented.
+ */
+static Bool
+RecordRingReserve(pContext, len)
+    RecordContextPtr pContext;
+    int len;
+{
+    if (pContext->ringSize - pContext->ringUsed - pContext->ringReserved < len)
+    {
+	pContext->numDropped++;
+	return FALSE;
+    }
+    pContext->ringReserved += len;
+    return TRUE;
+} /* RecordRingReserve */
+
+
+/* RecordDrainRing
+ *
+ * Arguments:
+ *	pContext is a context with a capture ring.
+ *
+ * Returns: nothing.
+ *
+ * Side Effects:
+ *	All protocol in the ring is written to the recording client.
+ */
+static void
+RecordDrainRing(pContext)
+    RecordContextPtr pContext;
+{
+    int n;
+
+    if (!pContext->pRecordingClient || pContext->pRecordingClient->clientGone)
+	return;
+    while (pContext->ringUsed)
+    {
+	n = pContext->ringSize - pContext->ringHead;
+	if (n > pContext->ringUsed)
+	    n = pContext->ringUsed;
+	WriteToClient(pContext->pRecordingClient, n,
+		      pContext->pRing + pContext->ringHead);
+	pContext->ringHead = (pContext->ringHead + n) % pContext->ringSize;
+	pContext->ringUsed -= n;
+    }
+    pContext->ringHead = 0;
+} /* RecordDrainRing */
+
+
 /* RecordFlushReplyBuffer
  *
  * Arguments:
@@ -248,6 +374,18 @@ RecordFlushReplyBuffer(pContext, data1, len1, data2, len2)
 {
     if (!pContext->pRecordingClient || pContext->pRecordingClient->clientGone) 
 	return;
+    if (pContext->pRing)
+    {
+	if (pContext->numBufBytes)
+	    RecordRingWrite(pContext, (pointer)pContext->replyBuffer,
+			    pContext->numBufBytes);
+	pContext->numBufBytes = 0;
+	if (len1)
+	    RecordRingWrite(pContext, data1, len1);
+	if (len2)
+	    RecordRingWrite(pContext, data2, len2);
+	return;
+    }
     if (pContext->numBufBytes)
 	WriteToClient(pContext->pRecordingClient, pContext->numBufBytes,
 		      (char *)pContext->replyBuffer);
@@ -303,6 +441,9 @@ RecordAProtocolElement(pContext, pClient, category, data, datalen, futurelen)
     Bool gotServerTime = FALSE;
     int replylen;
 
+    if (futurelen < 0 && pContext->droppingElement)
+	return; /* continuation of a dropped element */
+
     if (futurelen >= 0)
     { /* start of new protocol element */
 	xRecordEnableContextReply *pRep = (xRecordEnableContextReply *)
@@ -315,6 +456,27 @@ RecordAProtocolElement(pContext, pClient, category, data, datalen, futurelen)
 	    pContext->bufCategory = category;
 	}
 
+	if (pContext->pRing)
+	{
+	    int needed = datalen + futurelen;
+
+	    if (!pContext->numBufBytes)
+		needed += SIZEOF(xRecordEnableContextReply);
+	    if ( ( (pContext->elemHeaders & XRecordFromClientTime)
+		  && category == XRecordFromClient)
+		||
+		( (pContext->elemHeaders & XRecordFromServerTime)
+		 && category == XRecordFromServer))
+		needed += 4;
+	    if ( (pContext->elemHeaders & XRecordFromClientSequence)
+		&&
+		(category == XRecordFromClient || category == XRecordClientDied))
+		needed += 4;
+	    pContext->droppingElement = !RecordRingReserve(pContext, needed);
+	    if (pContext->droppingElement)
+		return;
+	}
+
 	if (!pContext->numBufBytes)
 	{
 	    serverTime = GetTimeInMillis();
@@ -539,8 +701,8 @@ RecordARequest(client)
 	pContext = ppAllContexts[i];
 	pRCAP = RecordFindClientOnContext(pContext, client->clientAsMask,
 					  NULL);
-	if (pRCAP && pRCAP->pRequestMajorOpSet &&
-	    RecordIsMemberOfSet(pRCAP->pRequestMajorOpSet, majorop))
+	if (pRCAP &&
+	    RecordIsMemberOfOpcodeMask(pRCAP->requestMajorOpMask, majorop))
 	{
 	    if (majorop <= 127)
 	    { /* core request */
@@ -634,8 +796,8 @@ RecordASkippedRequest(pcbl , nulldata, calldata)
 	    pContext = ppAllContexts[i];
 	    pRCAP = RecordFindClientOnContext(pContext, client->clientAsMask,
 					      NULL);
-	    if (pRCAP && pRCAP->pRequestMajorOpSet &&
-		RecordIsMemberOfSet(pRCAP->pRequestMajorOpSet, majorop))
+	    if (pRCAP &&
+		RecordIsMemberOfOpcodeMask(pRCAP->requestMajorOpMask, majorop))
 	    {
 		if (majorop <= 127)
 		{ /* core request */
@@ -725,8 +887,9 @@ RecordAReply(pcbl, nulldata, calldata)
 		if (!pri->bytesRemaining)
 		    pContext->continuedReply = 0;
 	    }
-	    else if (pri->startOfReply && pRCAP->pReplyMajorOpSet &&
-		     RecordIsMemberOfSet(pRCAP->pReplyMajorOpSet, majorop))
+	    else if (pri->startOfReply &&
+		     RecordIsMemberOfOpcodeMask(pRCAP->replyMajorOpMask,
+						majorop))
 	    {
 		if (majorop <= 127)
 		{ /* core reply */
@@ -807,13 +970,14 @@ RecordADeliveredEventOrError(pcbl, nulldata, calldata)
 		int recordit;
 		if (pev->u.u.type == X_Error)
 		{
-		    recordit = RecordIsMemberOfSet(pRCAP->pErrorSet,
+		    recordit = RecordIsMemberOfOpcodeMask(pRCAP->errorMask,
 						((xError *)(pev))->errorCode);
 		}
 		else
 		{
-		    recordit = RecordIsMemberOfSet(pRCAP->pDeliveredEventSet,
-						   pev->u.u.type & 0177);
+		    recordit = RecordIsMemberOfOpcodeMask(
+						pRCAP->deliveredEventMask,
+						pev->u.u.type & 0177);
 		}
 		if (recordit)
 		{
@@ -872,8 +1036,8 @@ RecordADeviceEvent(pcbl, nulldata, calldata)
 		xEvent *pev = pei->events;
 		for (ev = 0; ev < pei->count; ev++, pev++)
 		{
-		    if (RecordIsMemberOfSet(pRCAP->pDeviceEventSet,
-					    pev->u.u.type & 0177))
+		    if (RecordIsMemberOfOpcodeMask(pRCAP->deviceEventMask,
+						   pev->u.u.type & 0177))
 		    {
 		        xEvent swappedEvent;
 		        xEvent *pEvToRecord = pev;
@@ -919,6 +1083,116 @@ RecordADeviceEvent(pcbl, nulldata, calldata)
 } /* RecordADeviceEvent */
 
 
+/* RecordAllocRing
+ *
+ * Arguments:
+ *	pContext is a context being enabled.
+ *
+ * Returns: TRUE if a capture ring was allocated.
+ *
+ * Side Effects:
+ *	pContext->pRing is allocated with RecordRingSize bytes.  Where
+ *	possible the ring is mapped rather than allocated from the heap, so
+ *	its pages are returned to the system when the context is disabled.
+ */
+static Bool
+RecordAllocRing(pContext)
+    RecordContextPtr pContext;
+{
+    int size = RecordRingSize;
+    char *pRing;
+
+    /* must hold at least a reply header and an event */
+    if (size < SIZEOF(xRecordEnableContextReply) + SIZEOF(xEvent) + 8)
+	size = SIZEOF(xRecordEnableContextReply) + SIZEOF(xEvent) + 8;
+#ifdef RECORD_RING_MMAP
+    pRing = (char *)mmap(NULL, size, PROT_READ | PROT_WRITE,
+			 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (pRing == (char *)MAP_FAILED)
+	return FALSE;
+#else
+    pRing = (char *)xalloc(size);
+    if (!pRing)
+	return FALSE;
+#endif
+    pContext->pRing = pRing;
+    pContext->ringSize = size;
+    pContext->ringHead = pContext->ringUsed = pContext->ringReserved = 0;
+    pContext->droppingElement = 0;
+    pContext->numDropped = 0;
+    return TRUE;
+} /* RecordAllocRing */
+
+
+/* RecordFreeRing
+ *
+ * Arguments:
+ *	pContext is a context being disabled.
+ *
+ * Returns: nothing.
+ *
+ * Side Effects:
+ *	The capture ring of pContext, if any, is freed.  Any protocol still
+ *	in it is lost, so callers drain it first if the recording client is
+ *	still around.
+ */
+static void
+RecordFreeRing(pContext)
+    RecordContextPtr pContext;
+{
+    if (!pContext->pRing)
+	return;
+    if (pContext->numDropped)
+	ErrorF("RECORD: context 0x%lx dropped %lu protocol elements\n",
+	       (unsigned long)pContext->id, pContext->numDropped);
+#ifdef RECORD_RING_MMAP
+    munmap(pContext->pRing, pContext->ringSize);
+#else
+    xfree(pContext->pRing);
+#endif
+    pContext->pRing = NULL;
+    pContext->ringSize = 0;
+    pContext->ringHead = pContext->ringUsed = pContext->ringReserved = 0;
+    pContext->droppingElement = 0;
+} /* RecordFreeRing */
+
+
+/* RecordBlockHandler
+ *
+ * Arguments:
+ *	data, pTimeout and pReadmask are unused.
+ *
+ * Returns: nothing.
+ *
+ * Side Effects:
+ *	The capture rings of all enabled contexts whose recording clients
+ *	are accepting output are drained.  The server flushes the output
+ *	right after the block handlers run.  Rings of recording clients that
+ *	are not reading are left to fill up.
+ */
+static void
+RecordBlockHandler(data, pTimeout, pReadmask)
+    pointer data;
+    OSTimePtr pTimeout;
+    pointer pReadmask;
+{
+    int eci; /* enabled context index */
+    RecordContextPtr pContext;
+
+    for (eci = 0; eci < numEnabledContexts; eci++)
+    {
+	pContext = ppAllContexts[eci];
+	if (!pContext->pRing)
+	    continue;
+	if (pContext->numBufBytes)
+	    RecordFlushReplyBuffer(pContext, NULL, 0, NULL, 0);
+	if (pContext->ringUsed &&
+	    !ClientIsWriteBlocked(pContext->pRecordingClient))
+	    RecordDrainRing(pContext);
+    }
+} /* RecordBlockHandler */
+
+
 /* RecordFlushAllContexts
  *
  * Arguments:
@@ -1928,6 +2202,14 @@ RecordRegisterClients(pContext, client, stuff)
     }
     else pRCAP->pDeliveredEventSet = NULL;
 
+    RecordSetToOpcodeMask(pRCAP->pRequestMajorOpSet,
+			  pRCAP->requestMajorOpMask);
+    RecordSetToOpcodeMask(pRCAP->pReplyMajorOpSet, pRCAP->replyMajorOpMask);
+    RecordSetToOpcodeMask(pRCAP->pErrorSet, pRCAP->errorMask);
+    RecordSetToOpcodeMask(pRCAP->pDeviceEventSet, pRCAP->deviceEventMask);
+    RecordSetToOpcodeMask(pRCAP->pDeliveredEventSet,
+			  pRCAP->deliveredEventMask);
+
     if (nExtReqSets)
     {
 	pRCAP->pRequestMinOpInfo = (RecordMinorOpPtr)
@@ -2051,6 +2333,11 @@ ProcRecordCreateContext(client)
     pContext->numBufBytes = 0;
     pContext->pBufClient = NULL;
     pContext->continuedReply = 0;
+    pContext->pRing = NULL;
+    pContext->ringSize = 0;
+    pContext->ringHead = pContext->ringUsed = pContext->ringReserved = 0;
+    pContext->droppingElement = 0;
+    pContext->numDropped = 0;
 
     err = RecordRegisterClients(pContext, client,
 				(xRecordRegisterClientsReq *)stuff);
@@ -2533,6 +2820,20 @@ ProcRecordEnableContext(client)
     ++numEnabledContexts;
     assert(numEnabledContexts > 0);
 
+    /* In ring mode, protocol is drained from a block handler.  If the ring
+     * can't be allocated, the context simply records synchronously.
+     */
+    if (RecordRingSize > 0 && RecordAllocRing(pContext))
+    {
+	if (numRingContexts++ == 0 &&
+	    !RegisterBlockAndWakeupHandlers(RecordBlockHandler,
+				(WakeupHandlerProcPtr)NoopDDA, NULL))
+	{
+	    numRingContexts--;
+	    RecordFreeRing(pContext);
+	}
+    }
+
     /* send StartOfData */
     RecordAProtocolElement(pContext, NULL, XRecordStartOfData, NULL, 0, 0);
     RecordFlushReplyBuffer(pContext, NULL, 0, NULL, 0);
@@ -2568,9 +2869,18 @@ RecordDisableContext(pContext)
     {
 	RecordAProtocolElement(pContext, NULL, XRecordEndOfData, NULL, 0, 0);
 	RecordFlushReplyBuffer(pContext, NULL, 0, NULL, 0);
+	if (pContext->pRing)
+	    RecordDrainRing(pContext);
 	/* Re-enable request processing on this connection. */
 	AttendClient(pContext->pRecordingClient);
     }
+    if (pContext->pRing)
+    {
+	RecordFreeRing(pContext);
+	if (--numRingContexts == 0)
+	    RemoveBlockAndWakeupHandlers(RecordBlockHandler,
+				(WakeupHandlerProcPtr)NoopDDA, NULL);
+    }
 
     for (pRCAP = pContext->pListOfRCAP; pRCAP; pRCAP = pRCAP->pNextRCAP)
     {
@@ -3039,6 +3349,7 @@ RecordExtensionInit()
 
     ppAllContexts = NULL;
     numContexts = numEnabledContexts = numEnabledRCAPs = 0;
+    numRingContexts = 0;
 
     if (!AddCallback(&ClientStateCallback, RecordAClientStateChange, NULL))
 	return;
@@ -527,6 +527,25 @@ RecordCreateSet(pIntervals, nIntervals, pMem, memsize)
     return (*pCreateSet)(pIntervals, nIntervals, pMem, size);
 }
 
+void
+RecordSetToOpcodeMask(pSet, mask)
+    RecordSetPtr pSet;
+    RecordOpcodeMask mask;
+{
+    RecordSetIteratePtr pIter = NULL;
+    RecordSetInterval interval;
+    int i;
+
+    memset(mask, 0, sizeof(RecordOpcodeMask));
+    if (!pSet)
+	return;
+    while ((pIter = RecordIterateSet(pSet, pIter, &interval)))
+    {
+	for (i = interval.first; i <= (int)interval.last && i <= 255; i++)
+	    mask[i >> 3] |= 1 << (i & 7);
+    }
+}
+
 /***************************************************************************/
 
 #ifdef TESTING
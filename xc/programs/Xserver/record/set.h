@@ -129,6 +129,31 @@ int RecordSetMemoryRequirements(
     used after it is destroyed.
 */
 
+/* A flat bitmap over the 8-bit number space of major opcodes, event types
+   and error codes.  Testing membership takes no function call, so it is
+   used in the paths that filter every request, reply and event.
+*/
+typedef unsigned char RecordOpcodeMask[32];
+
+void RecordSetToOpcodeMask(
+#if NeedFunctionPrototypes
+    RecordSetPtr /*pSet*/,
+    RecordOpcodeMask /*mask*/
+#endif
+);
+/*
+    RecordSetToOpcodeMask sets the bits of mask for the members of pSet that
+    are less than 256 and clears all others.  pSet may be NULL, in which case
+    mask is cleared.
+*/
+
+#define RecordIsMemberOfOpcodeMask(_mask, _m) \
+  /* int */ ((_mask)[((_m) & 0xff) >> 3] & (1 << ((_m) & 7)))
+/*
+    RecordIsMemberOfOpcodeMask returns a non-zero value if _m, which must be
+    in the range 0 to 255, is set in _mask, else it returns zero.
+*/
+
 #define RecordIsMemberOfSet(_pSet, _m) \
   /* unsigned long */ (*_pSet->ops->IsMemberOfSet)(/* RecordSetPtr */ _pSet, \
 						   /* int */ _m) 
@@ -92,6 +92,310 @@ OutputDirectory (outdir)
     }
 }
 
+#ifndef WIN32
+#include <sys/stat.h>
+#include <dirent.h>
+#include <utime.h>
+#define	XKM_CACHE
+#endif
+
+#ifdef XKM_CACHE
+	/*
+	 * Compiled keymaps are kept in the output directory under a name
+	 * derived from the keymap source handed to xkbcomp, so a server
+	 * asking for a keymap that it or another server has compiled
+	 * before can load the .xkm without running the compiler.  Each
+	 * cache entry is a pair: the .xkm and a .src file holding a stamp
+	 * of the keymap data directory followed by the full source, which
+	 * must match exactly before the entry is used.
+	 */
+#define	XKM_CACHE_PREFIX	"xkbcache-"
+#define	XKM_CACHE_MAX_AGE	(30*24*60*60)	/* seconds since last use */
+
+static unsigned long
+XkbCacheHash (hash, data, len)
+    unsigned long	hash;
+    char *		data;
+    int			len;
+{
+    while (len--)
+	hash= ((hash ^ (unsigned char) *data++) * 16777619) & 0xffffffff;
+    return hash;
+}
+
+	/*
+	 * The data directory stamp covers the names, sizes and modification
+	 * times of everything in the component directories.  Entries are
+	 * summed so the order readdir returns them in doesn't matter.
+	 */
+static unsigned long
+XkbCacheStampDir (path, depth)
+    char *	path;
+    int		depth;
+{
+DIR *		dir;
+struct dirent *	ent;
+struct stat	st;
+char		name[PATH_MAX];
+unsigned long	sum, h;
+
+    sum= 0;
+    if ((dir= opendir(path))==NULL)
+	return sum;
+    while ((ent= readdir(dir))!=NULL) {
+	if ((ent->d_name[0]=='.')||
+	    (strlen(path)+strlen(ent->d_name)+2 > PATH_MAX))
+	    continue;
+	sprintf(name,"%s/%s",path,ent->d_name);
+	if (stat(name,&st) < 0)
+	    continue;
+	h= XkbCacheHash(2166136261UL,ent->d_name,strlen(ent->d_name));
+	h= XkbCacheHash(h,(char *) &st.st_size,sizeof(st.st_size));
+	h= XkbCacheHash(h,(char *) &st.st_mtime,sizeof(st.st_mtime));
+	if (S_ISDIR(st.st_mode) && depth > 0)
+	    h+= XkbCacheStampDir(name,depth-1);
+	sum+= h;
+    }
+    closedir(dir);
+    return sum & 0xffffffff;
+}
+
+static unsigned long
+XkbCacheStamp ()
+{
+static unsigned long	stamp;
+static int		stampGeneration;
+static char *		dirs[] = {
+    "keycodes", "types", "compat", "symbols", "geometry", "keymap",
+    "xkbcomp"
+};
+char			path[PATH_MAX];
+struct stat		st;
+int			i;
+
+    if (stampGeneration==serverGeneration)
+	return stamp;
+    stamp= 0;
+    if (XkbBaseDirectory!=NULL) {
+	for (i= 0; i < sizeof(dirs)/sizeof(dirs[0]); i++) {
+	    if (strlen(XkbBaseDirectory)+strlen(dirs[i])+2 > PATH_MAX)
+		continue;
+	    sprintf(path,"%s/%s",XkbBaseDirectory,dirs[i]);
+	    if (stat(path,&st) < 0)
+		continue;
+	    stamp= XkbCacheHash(stamp,dirs[i],strlen(dirs[i]));
+	    stamp= XkbCacheHash(stamp,(char *) &st.st_size,sizeof(st.st_size));
+	    stamp= XkbCacheHash(stamp,(char *) &st.st_mtime,sizeof(st.st_mtime));
+	    if (S_ISDIR(st.st_mode))
+		stamp+= XkbCacheStampDir(path,2);
+	}
+    }
+    stamp&= 0xffffffff;
+    stampGeneration= serverGeneration;
+    return stamp;
+}
+
+static Bool
+XkbCachePath (buf, outdir, name, ext)
+    char *	buf;
+    char *	outdir;
+    char *	name;
+    char *	ext;
+{
+    if ((XkbBaseDirectory!=NULL)&&(outdir[0]!='/')) {
+	if (strlen(XkbBaseDirectory)+strlen(outdir)+strlen(name)
+						+strlen(ext)+2 > PATH_MAX)
+	    return False;
+	sprintf(buf,"%s/%s%s%s",XkbBaseDirectory,outdir,name,ext);
+    }
+    else {
+	if (strlen(outdir)+strlen(name)+strlen(ext)+1 > PATH_MAX)
+	    return False;
+	sprintf(buf,"%s%s%s",outdir,name,ext);
+    }
+    return True;
+}
+
+	/*
+	 * Cache files may live in a world writable directory; only trust
+	 * those we own and nobody else can write
+	 */
+static Bool
+XkbCacheFileTrusted (fd)
+    int		fd;
+{
+struct stat	st;
+
+    return (fstat(fd,&st)==0 && S_ISREG(st.st_mode) &&
+	    st.st_uid==getuid() && (st.st_mode & 022)==0);
+}
+
+static void
+XkbCacheName (name, src, srcLen)
+    char *	name;
+    char *	src;
+    int		srcLen;
+{
+unsigned long	stamp = XkbCacheStamp();
+
+    sprintf(name,"%s%08lx-%08lx",XKM_CACHE_PREFIX,stamp,
+			XkbCacheHash(stamp ^ 2166136261UL,src,srcLen));
+}
+
+	/*
+	 * Entries are only ever added, so once per server generation drop
+	 * those made against a different data directory stamp (they can
+	 * never match again) and those unused for XKM_CACHE_MAX_AGE.  A
+	 * hit touches both files of its entry, which keeps it alive.
+	 * Stray temporary .src files from a crashed server go the same way.
+	 */
+static void
+XkbCachePrune (outdir)
+    char *	outdir;
+{
+static int	pruneGeneration;
+char		dir[PATH_MAX], path[PATH_MAX], current[20];
+DIR *		d;
+struct dirent *	ent;
+struct stat	st;
+time_t		now;
+int		prefixLen, currentLen;
+
+    if (pruneGeneration==serverGeneration)
+	return;
+    pruneGeneration= serverGeneration;
+    if (!XkbCachePath(dir,outdir,"","") || (d= opendir(dir))==NULL)
+	return;
+    sprintf(current,"%s%08lx-",XKM_CACHE_PREFIX,XkbCacheStamp());
+    prefixLen= strlen(XKM_CACHE_PREFIX);
+    currentLen= strlen(current);
+    now= time(NULL);
+    while ((ent= readdir(d))!=NULL) {
+	if (strncmp(ent->d_name,XKM_CACHE_PREFIX,prefixLen)!=0 ||
+	    !XkbCachePath(path,outdir,ent->d_name,"") ||
+	    lstat(path,&st) < 0 || !S_ISREG(st.st_mode) ||
+	    st.st_uid!=getuid())
+	    continue;
+	if (strncmp(ent->d_name,current,currentLen)!=0 ||
+	    now-st.st_mtime > XKM_CACHE_MAX_AGE)
+	    (void) unlink(path);
+    }
+    closedir(d);
+}
+
+static Bool
+XkbCacheFind (outdir, src, srcLen, name)
+    char *	outdir;
+    char *	src;
+    int		srcLen;
+    char *	name;
+{
+char		path[PATH_MAX];
+FILE *		file;
+char *		buf;
+unsigned long	stamp;
+Bool		found;
+
+    XkbCachePrune(outdir);
+    XkbCacheName(name,src,srcLen);
+    if (!XkbCachePath(path,outdir,name,".src") ||
+	(file= fopen(path,"r"))==NULL)
+	return False;
+    found= False;
+    if (XkbCacheFileTrusted(fileno(file)) &&
+	fscanf(file,"%lx\n",&stamp)==1 && stamp==XkbCacheStamp() &&
+	(buf= (char *) xalloc(srcLen+1))!=NULL) {
+	found= (fread(buf,1,srcLen+1,file)==srcLen &&
+		memcmp(buf,src,srcLen)==0);
+	xfree(buf);
+    }
+    fclose(file);
+    if (found) {
+	if (XkbCachePath(path,outdir,name,".xkm") &&
+	    (file= fopen(path,"r"))!=NULL) {
+	    found= XkbCacheFileTrusted(fileno(file));
+	    fclose(file);
+	}
+	else found= False;
+    }
+    if (found) {
+	(void) utime(path,NULL);
+	if (XkbCachePath(path,outdir,name,".src"))
+	    (void) utime(path,NULL);
+    }
+    return found;
+}
+
+	/*
+	 * Enter a freshly compiled keymap.  The .xkm is linked rather than
+	 * copied, and the .src only appears once the .xkm is in place, so a
+	 * server racing with this one never sees a partial entry.
+	 */
+static void
+XkbCacheStore (outdir, keymap, name, src, srcLen)
+    char *	outdir;
+    char *	keymap;
+    char *	name;
+    char *	src;
+    int		srcLen;
+{
+char	xkm[PATH_MAX],cached[PATH_MAX],tmp[PATH_MAX],path[PATH_MAX];
+char	tmpname[PATH_MAX];
+FILE *	file;
+Bool	ok;
+
+    sprintf(tmpname,"%s.%ld",name,(long) getpid());
+    if (!XkbCachePath(xkm,outdir,keymap,".xkm") ||
+	!XkbCachePath(cached,outdir,name,".xkm") ||
+	!XkbCachePath(tmp,outdir,tmpname,".src") ||
+	!XkbCachePath(path,outdir,name,".src"))
+	return;
+    (void) unlink(cached);
+    if (link(xkm,cached) < 0)
+	return;
+    if ((file= fopen(tmp,"w"))==NULL)
+	return;
+    ok= (fprintf(file,"%08lx\n",XkbCacheStamp()) > 0 &&
+	 fwrite(src,1,srcLen,file)==srcLen);
+    if (fclose(file)!=0)
+	ok= False;
+    if (!ok || rename(tmp,path) < 0)
+	(void) unlink(tmp);
+}
+
+	/*
+	 * Generate the keymap source xkbcomp would be fed
+	 */
+static char *
+XkbCacheKeymapSource (names, xkb, want, need, lenRtrn)
+    XkbComponentNamesPtr	names;
+    XkbDescPtr			xkb;
+    unsigned			want;
+    unsigned			need;
+    int *			lenRtrn;
+{
+FILE *	file;
+char *	src;
+long	len;
+
+    if ((file= tmpfile())==NULL)
+	return NULL;
+    src= NULL;
+    if (XkbWriteXKBKeymapForNames(file,names,NULL,xkb,want,need) &&
+	fflush(file)==0 && (len= ftell(file)) > 0 &&
+	fseek(file,0L,SEEK_SET)==0 &&
+	(src= (char *) xalloc(len))!=NULL) {
+	if (fread(src,1,len,file)!=len) {
+	    xfree(src);
+	    src= NULL;
+	}
+	*lenRtrn= len;
+    }
+    fclose(file);
+    return src;
+}
+#endif
+
 Bool
 #if NeedFunctionPrototypes
 XkbDDXCompileNamedKeymap(	XkbDescPtr		xkb,
@@ -107,6 +411,9 @@ XkbDDXCompileNamedKeymap(xkb,names,nameRtrn,nameRtrnLen)
 #endif
 {
 char 	cmd[PATH_MAX],file[PATH_MAX],xkm_output_dir[PATH_MAX],*map,*outFile;
+#ifdef XKM_CACHE
+char	cacheName[PATH_MAX];
+#endif
 
     if (names->keymap==NULL)
 	return False;
@@ -126,6 +433,18 @@ char 	cmd[PATH_MAX],file[PATH_MAX],xkm_output_dir[PATH_MAX],*map,*outFile;
     else outFile= _XkbDupString(file);
     XkbEnsureSafeMapName(outFile);
     OutputDirectory(xkm_output_dir);
+#ifdef XKM_CACHE
+    if (XkbKeymapCache &&
+	XkbCacheFind(xkm_output_dir,names->keymap,strlen(names->keymap),
+								cacheName)) {
+	if (nameRtrn) {
+	    strncpy(nameRtrn,cacheName,nameRtrnLen);
+	    nameRtrn[nameRtrnLen-1]= '\0';
+	}
+	_XkbFree(outFile);
+	return True;
+    }
+#endif
 
     if (XkbBaseDirectory!=NULL) {
 #ifdef __UNIXOS2__
@@ -189,6 +508,13 @@ char 	cmd[PATH_MAX],file[PATH_MAX],xkm_output_dir[PATH_MAX],*map,*outFile;
 	    strncpy(nameRtrn,outFile,nameRtrnLen);
 	    nameRtrn[nameRtrnLen-1]= '\0';
 	}
+#ifdef XKM_CACHE
+	if (XkbKeymapCache) {
+	    XkbCacheName(cacheName,names->keymap,strlen(names->keymap));
+	    XkbCacheStore(xkm_output_dir,outFile,cacheName,
+				names->keymap,strlen(names->keymap));
+	}
+#endif
 	if (outFile!=NULL)
 	    _XkbFree(outFile);
 	return True;
@@ -221,6 +547,11 @@ XkbDDXCompileKeymapByNames(xkb,names,want,need,nameRtrn,nameRtrnLen)
 {
 FILE *	out;
 char	buf[PATH_MAX],keymap[PATH_MAX],xkm_output_dir[PATH_MAX];
+#ifdef XKM_CACHE
+char	cacheName[PATH_MAX];
+char *	src= NULL;
+int	srcLen= 0;
+#endif
 #ifdef WIN32
 char tmpname[32];
 #endif    
@@ -241,6 +572,18 @@ int i;
 
     XkbEnsureSafeMapName(keymap);
     OutputDirectory(xkm_output_dir);
+#ifdef XKM_CACHE
+    if (XkbKeymapCache &&
+	(src= XkbCacheKeymapSource(names,xkb,want,need,&srcLen))!=NULL &&
+	XkbCacheFind(xkm_output_dir,src,srcLen,cacheName)) {
+	xfree(src);
+	if (nameRtrn) {
+	    strncpy(nameRtrn,cacheName,nameRtrnLen);
+	    nameRtrn[nameRtrnLen-1]= '\0';
+	}
+	return True;
+    }
+#endif
 #ifdef WIN32
     strcpy(tmpname, "\\temp\\xkb_XXXXXX");
     (void) mktemp(tmpname);
@@ -256,6 +599,10 @@ int i;
 	{
             ErrorF("compiler command for keymap (%s) exceeds max length\n",
 							names->keymap);
+#ifdef XKM_CACHE
+	    if (src)
+		xfree(src);
+#endif
 	    return False;
 	}
 #ifndef WIN32
@@ -294,6 +641,10 @@ int i;
 	{
             ErrorF("compiler command for keymap (%s) exceeds max length\n",
 							names->keymap);
+#ifdef XKM_CACHE
+	    if (src)
+		xfree(src);
+#endif
 	    return False;
 	}
 #ifndef WIN32
@@ -321,6 +672,11 @@ int i;
        ErrorF("XkbDDXCompileKeymapByNames compiling keymap:\n");
        XkbWriteXKBKeymapForNames(stderr,names,NULL,xkb,want,need);
     }
+#endif
+#ifdef XKM_CACHE
+	if (src)
+	    fwrite(src,1,srcLen,out);
+	else
 #endif
 	XkbWriteXKBKeymapForNames(out,names,NULL,xkb,want,need);
 #ifndef WIN32
@@ -361,6 +717,13 @@ int i;
 		if (i) ErrorF(">>>> Waited %d times for %s\n", i, name);
 #endif
 	    }
+#endif
+#ifdef XKM_CACHE
+	    if (src) {
+		XkbCacheName(cacheName,src,srcLen);
+		XkbCacheStore(xkm_output_dir,keymap,cacheName,src,srcLen);
+		xfree(src);
+	    }
 #endif
 	    return True;
 #ifdef WIN32
@@ -380,6 +743,10 @@ int i;
 	ErrorF("Could not open file %s\n", tmpname);
 #endif
     }
+#endif
+#ifdef XKM_CACHE
+    if (src)
+	xfree(src);
 #endif
     if (nameRtrn)
 	nameRtrn[0]= '\0';
@@ -490,6 +857,14 @@ unsigned	missing;
 	ErrorF("Error loading keymap %s\n",fileName);
 	fclose(file);
 	(void) unlink (fileName);
+#ifdef XKM_CACHE
+	if (strncmp(nameRtrn,XKM_CACHE_PREFIX,strlen(XKM_CACHE_PREFIX))==0) {
+	    /* drop the whole entry so the next load recompiles */
+	    fileName[strlen(fileName)-4]= '\0';
+	    strcat(fileName,".src");
+	    (void) unlink (fileName);
+	}
+#endif
 	return 0;
     }
 #ifdef DEBUG
@@ -498,6 +873,9 @@ unsigned	missing;
     }
 #endif
     fclose(file);
+#ifdef XKM_CACHE
+    if (strncmp(nameRtrn,XKM_CACHE_PREFIX,strlen(XKM_CACHE_PREFIX))!=0)
+#endif
     (void) unlink (fileName);
     return (need|want)&(~missing);
 }
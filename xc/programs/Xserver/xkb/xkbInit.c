@@ -119,6 +119,7 @@ int	 		XkbWantAccessX=		0;
 static XkbFileInfo *	_XkbInitFileInfo=	NULL;
 char *			XkbDB=			NULL;
 int			XkbAutoLoad=		1;
+int			XkbKeymapCache=		1;
 
 static Bool		rulesDefined=		False;
 static char *		XkbRulesFile=		NULL;
@@ -1046,6 +1047,10 @@ XkbProcessArguments(argc,argv,i)
 	XkbAutoLoad= 0;
 	return 1;
     }
+    else if (strcmp(argv[i], "-noxkbcache") == 0) {
+	XkbKeymapCache= 0;
+	return 1;
+    }
     else if ((strncmp(argv[i],"-accessx",8)==0)||
                  (strncmp(argv[i],"+accessx",8)==0)) {
 	int j=1;	    
@@ -1112,6 +1117,7 @@ XkbUseMsg()
     ErrorF("-ar1                   set XKB autorepeat delay\n");
     ErrorF("-ar2                   set XKB autorepeat interval\n");
     ErrorF("-noloadxkb             don't load XKB keymap description\n");
+    ErrorF("-noxkbcache            don't reuse previously compiled keymaps\n");
     ErrorF("-xkbdb                 file that contains default XKB keymaps\n");
     ErrorF("-xkbmap                XKB keyboard description to load on startup\n");
 }